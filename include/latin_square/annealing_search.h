@@ -0,0 +1,97 @@
+/**
+ * @file annealing_search.h
+ * @brief 模拟退火引擎：随机采样行内交换，用 O(1) 的冲突数增量评估，按 Metropolis 准则接受
+ *
+ * 每步只评估一个候选交换，不扫描整个邻域，单步代价远低于 LocalSearch::find_move，适合大规模实例
+ * 或作为组合求解中的廉价补充：
+ * - 采样：以 conflict_directed 的概率从随机冲突行的冲突节点出发，否则任选一行的非固定格；
+ *   另一格在同行非固定格中随机选取，优先选择交换后两格颜色都在颜色域内的交换；
+ * - 接受：冲突数不增加的交换总是接受，增加 delta 的交换以 exp(-delta / T) 的概率接受；
+ * - 温度：每 epoch_length 次采样 T 乘以 cooling_rate，低于 final_temperature 时重新加热到
+ *   initial_temperature（可选先回到历史最优解）。
+ */
+
+#ifndef LATINSQUARECOMPLETION_ANNEALING_SEARCH_H
+#define LATINSQUARECOMPLETION_ANNEALING_SEARCH_H
+
+#include "latin_square/engine.h"
+#include "latin_square/evaluator.h"
+#include "latin_square/latin_square.h"
+#include "latin_square/move.h"
+#include "latin_square/row_conflict_grid.h"
+#include "latin_square/search_workspace.h"
+#include "latin_square/telemetry.h"
+#include "latin_square/vec_set.h"
+
+#include <atomic>
+#include <vector>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 模拟退火参数
+ */
+struct AnnealingConfig {
+    double initial_temperature      = 0.5;  // 初始（及重新加热后的）温度
+    double final_temperature        = 0.05; // 低于该温度时重新加热
+    double cooling_rate             = 0.999;// 每个温度阶段结束时的降温系数
+    unsigned long long epoch_length = 0;    // 每个温度阶段的采样次数，0 表示取非固定格数
+    bool reheat_from_best           = true; // 重新加热前是否回到历史最优解
+    double conflict_directed        = 0.9;  // 从冲突节点出发采样的概率
+    int domain_attempts             = 4;    // 为找到颜色域内的交换最多尝试的次数
+    bool verbose                    = true; // 是否向 std::clog 输出搜索进度
+};
+
+class AnnealingSearch : public SearchEngine {
+public:
+    explicit AnnealingSearch(const AnnealingConfig &config = {})
+        : config_(config), evaluator_(workspace_.resource()), row_grid_(workspace_.resource()), conflict_rows_(workspace_.resource()) {}
+
+    AnnealingSearch(const AnnealingSearch &)            = delete;
+    AnnealingSearch &operator=(const AnnealingSearch &) = delete;
+
+    [[nodiscard]] std::string_view name() const override { return "annealing"; }
+
+    void search(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration = 0, double time_limit_seconds = 0) override;
+
+    void set_config(const AnnealingConfig &config) { config_ = config; }
+    [[nodiscard]] const AnnealingConfig &config() const { return config_; }
+
+    void set_improvement_callback(ImprovementCallback callback) override { on_improvement_ = std::move(callback); }
+    void set_stop_flag(const std::atomic<bool> *stop_flag) override { stop_flag_ = stop_flag; }
+
+    [[nodiscard]] const Solution &best_solution() const override { return best_solution_; }
+    // 采样（评估）过的候选交换数
+    [[nodiscard]] unsigned long long iteration() const override { return iteration_; }
+    [[nodiscard]] const SearchTelemetry &telemetry() const override { return telemetry_; }
+
+private:
+    // 工作区必须先于从中分配内存的成员构造、后于它们析构
+    SearchWorkspace workspace_;
+    AnnealingConfig config_;
+    ImprovementCallback on_improvement_;
+    const std::atomic<bool> *stop_flag_{nullptr};
+    SearchTelemetry telemetry_;
+    unsigned long long iteration_{};
+    const LatinSquare *latin_square_{nullptr};// 只在搜索期间引用调用方的拉丁方，search 返回时置空
+    Solution current_solution_;
+    Solution best_solution_;
+    Evaluator evaluator_;
+    RowConflictGrid row_grid_;
+    VecSet conflict_rows_;      // 含冲突节点的行
+    std::vector<int> free_rows_;// 至少有两个非固定格的行
+    double temperature_{0};
+
+    // search 的主体，返回后由 search 解除对拉丁方的引用
+    void run_(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration, double time_limit_seconds);
+    void prepare_workspace_(int N);
+    void update_best_();
+    // 采样一个候选交换（search 开始时已保证存在可交换的行）
+    [[nodiscard]] Move sample_move_() const;
+    void make_move_(const Move &move);
+    void reheat_();
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_ANNEALING_SEARCH_H
@@ -0,0 +1,84 @@
+/**
+ * @file anytime.h
+ * @brief 随时可用（anytime）输出：历史最优解改进时把解写入旁路文件，供外部调度随时读取部分结果
+ *
+ * 写入经过限速：距上次写入不足 min_interval_seconds 时只暂存，由后台定时线程在间隔期满时写出，
+ * 搜索停在平台期时旁路文件也不会停留在旧解上；flush() 立即写出暂存的解。
+ * 每次写入先写 path.tmp 再原子重命名，读取方不会看到写了一半的文件。
+ */
+
+#ifndef LATINSQUARECOMPLETION_ANYTIME_H
+#define LATINSQUARECOMPLETION_ANYTIME_H
+
+#include "latin_square/latin_square.h"
+#include "latin_square/local_search.h"
+#include "latin_square/solution_writer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace qm::latin_square {
+
+class AnytimeWriter {
+public:
+    /**
+     * @param path 旁路文件路径
+     * @param min_interval_seconds 两次写入之间的最短间隔（秒），不大于 0 表示每次改进都写
+     * @param binary 是否以二进制解记录（LSQS）写出，否则为文本格式
+     */
+    explicit AnytimeWriter(std::string path, double min_interval_seconds = 1.0, bool binary = false);
+
+    // 停止定时线程；暂存的解不会自动写出，需要时先调用 flush()
+    ~AnytimeWriter();
+
+    AnytimeWriter(const AnytimeWriter &)            = delete;
+    AnytimeWriter &operator=(const AnytimeWriter &) = delete;
+
+    /**
+     * @brief 提交新的历史最优解；满足限速条件时立即写出，否则暂存，由定时线程在间隔期满时写出
+     * @throw std::runtime_error 写入失败
+     */
+    void offer(const Solution &best);
+
+    /**
+     * @brief 立即写出暂存的解（若有）
+     * @throw std::runtime_error 写入失败
+     */
+    void flush();
+
+    /**
+     * @brief 适配为 Solver / LocalSearch 的改进回调
+     */
+    [[nodiscard]] ImprovementCallback callback() {
+        return [this](const Solution &best, unsigned long long) { offer(best); };
+    }
+
+    [[nodiscard]] const std::string &path() const { return path_; }
+    [[nodiscard]] unsigned long long writes() const;
+
+private:
+    std::string path_;
+    std::chrono::steady_clock::duration min_interval_;
+    bool binary_;
+    bool has_pending_{false};
+    bool has_written_{false};
+    std::chrono::steady_clock::time_point last_write_;
+    unsigned long long writes_{0};
+    Solution pending_;
+    SolutionWriter writer_;
+    mutable std::mutex mutex_;// 保护以上状态，写文件时也持有
+    std::condition_variable wake_;
+    bool stopping_{false};
+    std::thread timer_;// 间隔期满时写出暂存的解
+
+    void write_(const Solution &solution);
+    void run_timer_();
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_ANYTIME_H
@@ -0,0 +1,136 @@
+/**
+ * @file binary_io.h
+ * @brief 实例与解的紧凑二进制格式（带版本号，可直接 mmap 读取）
+ *
+ * 所有多字节字段均为小端序，每条记录按 8 字节对齐，便于拼接与内存映射：
+ * - 实例记录 "LSQI"：头部 16 字节，随后是 n*n 位的固定格位图，再是按最小位宽打包的固定值（行优先）
+ * - 解记录   "LSQS"：头部 16 字节，随后是按最小位宽打包的 n*n 个格子（行优先）
+ * - 实例包   "LSQB"：头部 16 字节，随后是 count 个 u64 绝对偏移索引，再是依次排列的实例记录
+ */
+
+#ifndef LATINSQUARECOMPLETION_BINARY_IO_H
+#define LATINSQUARECOMPLETION_BINARY_IO_H
+
+#include "latin_square/instance.h"
+#include "latin_square/latin_square.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace qm::latin_square::binary {
+
+inline constexpr std::uint16_t FORMAT_VERSION   = 1;
+inline constexpr std::size_t RECORD_ALIGNMENT   = 8;
+inline constexpr std::size_t RECORD_HEADER_SIZE = 16;
+
+using Bytes    = std::vector<std::uint8_t>;
+using ByteSpan = std::span<const std::uint8_t>;
+
+/**
+ * @brief 表示 [0, n) 内的值所需的最小位宽
+ */
+[[nodiscard]] int value_bit_width(int n);
+
+/**
+ * @brief 判断内存块是否以实例/解/实例包的魔数开头
+ */
+[[nodiscard]] bool is_instance_record(ByteSpan data);
+[[nodiscard]] bool is_solution_record(ByteSpan data);
+[[nodiscard]] bool is_bundle(ByteSpan data);
+
+// ==== 实例 ====
+
+[[nodiscard]] std::size_t instance_record_size(int n, std::size_t fixed_count);
+/**
+ * @brief 将实例编码追加到 out 末尾（重复的固定格保留最后一次赋值）
+ */
+void encode_instance(const Instance &instance, Bytes &out);
+/**
+ * @brief 从内存中解码一条实例记录
+ * @param consumed 若非空，返回该记录占用的字节数（含对齐填充）
+ * @throw std::runtime_error 数据损坏或版本不支持
+ */
+[[nodiscard]] Instance decode_instance(ByteSpan data, std::size_t *consumed = nullptr);
+void write_instance(std::ostream &os, const Instance &instance);
+[[nodiscard]] Instance read_instance(std::istream &is);
+
+// ==== 解 ====
+
+[[nodiscard]] std::size_t solution_record_size(int n);
+void encode_solution(const Solution &solution, Bytes &out);
+[[nodiscard]] Solution decode_solution(ByteSpan data, std::size_t *consumed = nullptr);
+void write_solution(std::ostream &os, const Solution &solution);
+[[nodiscard]] Solution read_solution(std::istream &is);
+
+// ==== 实例包 ====
+
+/**
+ * @brief 将多个实例写成一个带索引的实例包
+ */
+void write_bundle(std::ostream &os, std::span<const Instance> instances);
+
+/**
+ * @brief 实例包的只读视图，不拷贝底层数据（通常指向 MappedFile）
+ */
+class BundleView {
+public:
+    BundleView() = default;
+    /**
+     * @throw std::runtime_error 头部或索引损坏
+     */
+    explicit BundleView(ByteSpan data);
+
+    [[nodiscard]] std::size_t size() const { return offsets_.size(); }
+    [[nodiscard]] bool empty() const { return offsets_.empty(); }
+
+    /**
+     * @brief 第 i 条实例记录的原始字节
+     */
+    [[nodiscard]] ByteSpan record(std::size_t i) const;
+
+    /**
+     * @brief 解码第 i 个实例
+     */
+    [[nodiscard]] Instance at(std::size_t i) const { return decode_instance(record(i)); }
+
+private:
+    ByteSpan data_;
+    std::vector<std::uint64_t> offsets_;
+};
+
+/**
+ * @brief 只读映射整个文件；不支持 mmap 的平台退化为一次性读入内存
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    /**
+     * @throw std::runtime_error 文件无法打开或映射
+     */
+    explicit MappedFile(const std::string &path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &)            = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    [[nodiscard]] ByteSpan bytes() const { return {data_, size_}; }
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+    const std::uint8_t *data_{nullptr};
+    std::size_t size_{0};
+    bool mapped_{false};
+    Bytes fallback_;
+
+    void release() noexcept;
+};
+
+}// namespace qm::latin_square::binary
+
+#endif// LATINSQUARECOMPLETION_BINARY_IO_H
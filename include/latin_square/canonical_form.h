@@ -0,0 +1,43 @@
+/**
+ * @file canonical_form.h
+ * @brief 实例的规范形式：对行、列、符号分别重新编号，使同构实例尽量得到相同的规范实例
+ *
+ * 行、列、符号三类对象的标签按固定格关系迭代细化（类似 Weisfeiler-Lehman 颜色细化），
+ * 每类对象按标签排序得到规范编号，标签相同的对象按原编号排列。
+ * 细化能区分全部对象时，行/列/符号置换得到的实例映射到同一规范实例；
+ * 否则只保证完全相同的实例得到相同的规范实例。规范实例本身可以直接比较，哈希只用于索引。
+ */
+
+#ifndef LATINSQUARECOMPLETION_CANONICAL_FORM_H
+#define LATINSQUARECOMPLETION_CANONICAL_FORM_H
+
+#include "latin_square/instance.h"
+#include "latin_square/latin_square.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace qm::latin_square {
+
+struct CanonicalForm {
+    Instance instance;             // 规范实例，固定格按 (行, 列) 升序排列
+    std::uint64_t hash{0};         // 规范实例的内容哈希（规模与全部固定格的 Zobrist 键）
+    std::vector<int> row_map;      // 原行号 -> 规范行号
+    std::vector<int> col_map;      // 原列号 -> 规范列号
+    std::vector<int> symbol_map;   // 原符号 -> 规范符号
+
+    // 把原实例上的方阵映射到规范编号
+    [[nodiscard]] Solution to_canonical(const Solution &solution) const;
+    // 把规范编号下的方阵映射回原实例
+    [[nodiscard]] Solution from_canonical(const Solution &solution) const;
+};
+
+/**
+ * @brief 计算实例的规范形式，重复出现的固定格以最后一次赋值为准
+ * @throw std::invalid_argument 固定格坐标或取值超出范围
+ */
+[[nodiscard]] CanonicalForm canonicalize(const Instance &instance);
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_CANONICAL_FORM_H
@@ -0,0 +1,93 @@
+/**
+ * @file checkpoint.h
+ * @brief 局部搜索检查点：保存完整搜索状态，恢复后继续搜索的轨迹与不中断时逐位一致
+ *
+ * 检查点为小端序二进制文件 "LSQC"，包含：迭代次数、重启阈值 rt/accu、当前解与历史最优解、
+ * 各行冲突/非冲突节点集合（保留元素顺序，find_move 的平局随机选择依赖该顺序）、
+ * 尚未到期的禁忌表项、扰动与反应式禁忌期控制器的状态、最近访问过的解哈希、路径重连的精英池以及随机数引擎状态。记录表（Evaluator）由当前解重建，不写入文件。
+ * 文件末尾附带 FNV-1a 校验和，写入时先写临时文件再原子重命名，避免中途被抢占留下半个文件。
+ */
+
+#ifndef LATINSQUARECOMPLETION_CHECKPOINT_H
+#define LATINSQUARECOMPLETION_CHECKPOINT_H
+
+#include "latin_square/instance.h"
+#include "latin_square/latin_square.h"
+#include "latin_square/tabu_tenure.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace qm::latin_square {
+
+struct SearchCheckpoint {
+    static constexpr std::uint16_t FORMAT_VERSION = 1;
+
+    // 实例标识，恢复时校验
+    int n{0};
+    std::uint32_t fixed_count{0};
+    std::uint64_t instance_fingerprint{0};
+
+    unsigned long long iteration{0};
+    int rt{0};
+    int accu{0};
+    double elapsed_seconds{0};// 截至保存时累计的搜索时间（含之前恢复前的各段）
+    int perturbation_stagnation{0};    // 扰动：连续未改进的重启次数
+    bool improved_since_restart{false};// 上一次重启以来是否改进过历史最优解
+    std::optional<TabuTenureController::State> tenure;// 反应式禁忌期状态，缺失时恢复为初值
+
+    Solution current;
+    Solution best;
+
+    std::vector<std::vector<int>> row_conflict_grid;   // 每行冲突节点（列号，按集合内顺序）
+    std::vector<std::vector<int>> row_nonconflict_grid;// 每行非冲突节点
+
+    // 尚未到期的禁忌表项：(一维下标, 到期迭代次数)
+    std::vector<std::pair<std::uint32_t, unsigned long long>> tabu;
+
+    // 最近访问过的解哈希：旧一代与新一代
+    std::vector<std::uint64_t> visited_older;
+    std::vector<std::uint64_t> visited_newer;
+
+    // 路径重连：上一次重连以来的重启次数与精英池成员（按池内顺序）
+    int restarts_since_relink{0};
+    std::vector<Solution> elites;
+
+    std::string rng_state;
+
+    /**
+     * @brief 校验检查点是否属于给定实例
+     * @throw std::runtime_error 规模、固定格数或实例指纹不一致
+     */
+    void check_instance(const Instance &instance) const;
+};
+
+/**
+ * @brief 实例指纹：对规模与所有固定格做 FNV-1a 哈希
+ */
+[[nodiscard]] std::uint64_t instance_fingerprint(const Instance &instance);
+
+void encode_checkpoint(const SearchCheckpoint &checkpoint, std::vector<std::uint8_t> &out);
+
+/**
+ * @throw std::runtime_error 数据截断、校验和不符或版本不支持
+ */
+[[nodiscard]] SearchCheckpoint decode_checkpoint(const std::vector<std::uint8_t> &data);
+
+/**
+ * @brief 原子地写入检查点文件（先写 path.tmp 再重命名）
+ * @throw std::runtime_error 写入失败
+ */
+void save_checkpoint(const std::string &path, const SearchCheckpoint &checkpoint);
+
+/**
+ * @throw std::runtime_error 文件无法读取或内容损坏
+ */
+[[nodiscard]] SearchCheckpoint load_checkpoint(const std::string &path);
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_CHECKPOINT_H
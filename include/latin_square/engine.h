@@ -0,0 +1,118 @@
+/**
+ * @file engine.h
+ * @brief 搜索引擎公共接口：从初始解出发搜索，维护历史最优解
+ *
+ * 各引擎共用 Evaluator 的记录表与 RowConflictGrid，只在移动选择与跳出局部最优的策略上不同，
+ * 便于在同一批实例上比较或并行竞速。
+ */
+
+#ifndef LATINSQUARECOMPLETION_ENGINE_H
+#define LATINSQUARECOMPLETION_ENGINE_H
+
+#include "latin_square/latin_square.h"
+#include "latin_square/telemetry.h"
+
+#include <atomic>
+#include <functional>
+#include <string_view>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 历史最优解严格改进时的回调
+ * @param best 当前的历史最优解
+ * @param iteration 当前迭代次数
+ */
+using ImprovementCallback = std::function<void(const Solution &best, unsigned long long iteration)>;
+
+// 可选的搜索引擎
+enum class EngineKind {
+    TABU,     // 迭代禁忌搜索（LocalSearch）
+    WEIGHTING,// 约束加权 + 配置检测（WeightingSearch）
+    ANNEALING,// 模拟退火（AnnealingSearch）
+    MEMETIC,  // 模因算法（MemeticSearch）
+    EXACT,    // 精确回溯（ExactSearch）
+    PORTFOLIO,// 并行组合（PortfolioSearch）
+    AUTO,     // 按实例特征自动选择（engine_selector.h）
+};
+
+/**
+ * @brief 按名称（"tabu" / "weighting" / "annealing" / "memetic" / "exact" / "portfolio" / "auto"）解析引擎类型
+ * @return 名称无法识别时返回 false，kind 不变
+ */
+inline bool parse_engine_kind(const std::string_view name, EngineKind &kind) {
+    if (name == "tabu") {
+        kind = EngineKind::TABU;
+        return true;
+    }
+    if (name == "weighting") {
+        kind = EngineKind::WEIGHTING;
+        return true;
+    }
+    if (name == "annealing") {
+        kind = EngineKind::ANNEALING;
+        return true;
+    }
+    if (name == "memetic") {
+        kind = EngineKind::MEMETIC;
+        return true;
+    }
+    if (name == "exact") {
+        kind = EngineKind::EXACT;
+        return true;
+    }
+    if (name == "portfolio") {
+        kind = EngineKind::PORTFOLIO;
+        return true;
+    }
+    if (name == "auto") {
+        kind = EngineKind::AUTO;
+        return true;
+    }
+    return false;
+}
+
+// parse_engine_kind 的逆映射
+inline std::string_view engine_kind_name(const EngineKind kind) {
+    switch (kind) {
+        case EngineKind::TABU: return "tabu";
+        case EngineKind::WEIGHTING: return "weighting";
+        case EngineKind::ANNEALING: return "annealing";
+        case EngineKind::MEMETIC: return "memetic";
+        case EngineKind::EXACT: return "exact";
+        case EngineKind::PORTFOLIO: return "portfolio";
+        case EngineKind::AUTO: return "auto";
+    }
+    return "unknown";
+}
+
+class SearchEngine {
+public:
+    virtual ~SearchEngine() = default;
+
+    // 引擎名称，用于日志与命令行选择
+    [[nodiscard]] virtual std::string_view name() const = 0;
+
+    /**
+     * @brief 从给定初始解开始搜索，找到可行解、达到迭代上限或时间限制、或停止标志置位时返回
+     * @param max_iteration 最大迭代次数
+     * @param time_limit_seconds 时间限制（秒），不大于 0 表示不限时
+     */
+    virtual void search(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration, double time_limit_seconds) = 0;
+
+    [[nodiscard]] virtual const Solution &best_solution() const = 0;
+    [[nodiscard]] virtual unsigned long long iteration() const = 0;
+    // 本次运行的遥测计数
+    [[nodiscard]] virtual const SearchTelemetry &telemetry() const = 0;
+
+    virtual void set_improvement_callback(ImprovementCallback callback) = 0;
+
+    /**
+     * @brief 设置外部停止标志，标志置位后搜索在当前迭代结束时返回
+     */
+    virtual void set_stop_flag(const std::atomic<bool> *stop_flag) = 0;
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_ENGINE_H
@@ -0,0 +1,44 @@
+/**
+ * @file engine_selector.h
+ * @brief 按实例特征自动选择搜索引擎
+ *
+ * 规则按顺序判断：
+ * 1. 化简后非固定格不多于 exact_max_free_cells：精确回溯；
+ * 2. 规模不小于 portfolio_min_n、预填比例落在 [portfolio_min_fill, portfolio_max_fill]（相变附近的难区间）
+ *    且硬件线程数不少于 portfolio_min_threads：并行组合；
+ * 3. 其余：禁忌搜索。
+ * 默认阈值按手工测得的结果设定；部署时可以用 "key = value" 格式的手写文本文件覆盖（# 开头为注释）。
+ */
+
+#ifndef LATINSQUARECOMPLETION_ENGINE_SELECTOR_H
+#define LATINSQUARECOMPLETION_ENGINE_SELECTOR_H
+
+#include "latin_square/engine.h"
+#include "latin_square/instance_features.h"
+
+#include <string>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 引擎选择阈值
+ */
+struct SelectorThresholds {
+    int exact_max_free_cells  = 200; // 非固定格不多于该值时使用精确回溯
+    int portfolio_min_n       = 50;  // 使用并行组合的最小规模
+    double portfolio_min_fill = 0.55;// 使用并行组合的预填比例下限
+    double portfolio_max_fill = 0.7; // 使用并行组合的预填比例上限
+    int portfolio_min_threads = 2;   // 使用并行组合所需的最少硬件线程数
+};
+
+[[nodiscard]] EngineKind select_engine(const InstanceFeatures &features, const SelectorThresholds &thresholds, unsigned hardware_threads);
+
+/**
+ * @brief 读取阈值文件，文件中未出现的键保持默认值
+ * @throw std::runtime_error 文件无法读取、存在无法识别的键或取值无法解析
+ */
+[[nodiscard]] SelectorThresholds load_selector_thresholds(const std::string &path);
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_ENGINE_SELECTOR_H
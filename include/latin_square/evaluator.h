@@ -7,22 +7,35 @@
 #include "latin_square/latin_square.h"
 #include "vec_set.h"
 
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <type_traits>
+
 namespace qm::latin_square {
 
 
 /**
  * @brief 列内颜色数记录表
  * @details 使用 VecSet 存储每个 (颜色, 列) 对应的行集合
- * table_[color][col] 存储在第 col 列使用 color 颜色的所有行
+ * table_[color * N + col] 存储在第 col 列使用 color 颜色的所有行
  * size 表示该 (颜色, 列) 对的行数，用于快速判断冲突
  */
 struct ColColorNumTable {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
     ColColorNumTable() = default;
 
-    explicit ColColorNumTable(const Solution &solution);
+    explicit ColColorNumTable(const allocator_type &alloc) : table_(alloc) {}
 
+    explicit ColColorNumTable(const Solution &solution, const allocator_type &alloc = {});
+
+    // 重建记录表；规模不变时复用已有的集合，不再分配内存
     void set_table(const Solution &solution);
 
+    // 归还记录表占用的内存
+    void release() { std::pmr::vector<VecSet>(table_.get_allocator()).swap(table_); }
+
     [[nodiscard]] int get_move_delta(const Solution &solution, const Move &move) const;
 
     // warn: 先更新记录表，再更新解
@@ -31,61 +44,149 @@ struct ColColorNumTable {
         int color;
         int col;
     };
-    std::vector<AffectedCell> make_move(const Solution &old_solution, const Move &move);
+    using AffectedCells = std::array<AffectedCell, 4>;
+    AffectedCells make_move(const Solution &old_solution, const Move &move);
 
     [[nodiscard]] bool is_conflict_grid(int color, int col) const {
-        return table_[color][col].size() > 1;
+        return table_[color * N_ + col].size() > 1;
     }
 
     // 获取在第 col 列使用 color 颜色的所有行
     [[nodiscard]] const VecSet &get_rows(int color, int col) const {
-        return table_[color][col];
+        return table_[color * N_ + col];
     }
 
-    std::vector<std::vector<VecSet>> table_;// table_[color][col] = 使用该颜色的行集合
+    int N_{};
+    std::pmr::vector<VecSet> table_;// table_[color * N_ + col] = 使用该颜色的行集合
 };
 
 /**
  * @brief 每个格子的当前颜色是否在颜色域内，0 表示在，1 表示不在
+ * @details 只引用构造或 set_table 时的拉丁方，不持有副本：拉丁方须在记录表使用期间保持有效，
+ *          使用结束后以 detach() 解除引用
  */
 struct ColorInDomainTable {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
     ColorInDomainTable() = default;
-    explicit ColorInDomainTable(const Solution &solution, const LatinSquare &latin_square);
+    explicit ColorInDomainTable(const allocator_type &alloc) : table_(alloc) {}
+    explicit ColorInDomainTable(const Solution &solution, const LatinSquare &latin_square, const allocator_type &alloc = {});
+    // latin_square 须在记录表使用期间保持有效
     void set_table(const Solution &solution, const LatinSquare &latin_square);
+    void release() { std::pmr::vector<std::uint8_t>(table_.get_allocator()).swap(table_); }
 
     [[nodiscard]] int get_move_delta(const Solution &solution, const Move &move) const;
 
     // warn: 先更新记录表，再更新解
     void make_move(const Solution &old_solution, const Move &move);
 
-    [[nodiscard]] bool is_in_domain(int i, int j) const { return table_[i][j] == 0; }
+    [[nodiscard]] bool is_in_domain(int i, int j) const { return table_[i * N_ + j] == 0; }
+
+    // 解除对拉丁方的引用，再次使用前须 set_table
+    void detach() { latin_square_ = nullptr; }
+
+    const LatinSquare *latin_square_{nullptr};
+    int N_{};
+    std::pmr::vector<std::uint8_t> table_;
+};
+
+/**
+ * @brief 目标策略：一级评估函数总是冲突数
+ * @details DomainTieBreak：一级相同时以颜色域冲突数（二级评估函数）决胜，维护 ColorInDomainTable；
+ *          PrimaryOnly：不维护颜色域记录表，二级评估函数恒为 0，Solution::domain_conflict 保持初始值。
+ */
+struct DomainTieBreak {
+    static constexpr bool uses_domain = true;
+};
+
+struct PrimaryOnly {
+    static constexpr bool uses_domain = false;
+};
+
+/**
+ * @brief PrimaryOnly 下代替 ColorInDomainTable 的空表，全部操作在编译期消去
+ */
+struct NoDomainTable {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    NoDomainTable() = default;
+    explicit NoDomainTable(const allocator_type &) {}
+    NoDomainTable(const Solution &, const LatinSquare &, const allocator_type & = {}) {}
+    void set_table(const Solution &, const LatinSquare &) {}
+    void release() {}
+    void detach() {}
 
-    LatinSquare latin_square_;
-    std::vector<std::vector<int>> table_;
+    [[nodiscard]] int get_move_delta(const Solution &, const Move &) const { return 0; }
+
+    void make_move(const Solution &, const Move &) {}
 };
 
-class Evaluator {
+/**
+ * @brief 评估器：维护冲突记录表与颜色域记录表，计算移动的一级、二级评估值
+ * @details 评估器只引用 reset 或构造时的拉丁方，不持有副本，拉丁方须在评估器使用期间保持有效；
+ *          引擎在每次搜索结束时调用 detach()，搜索返回后评估器不再引用调用方的拉丁方
+ */
+template<typename Objective>
+class BasicEvaluator {
     friend class LocalSearch;
 
 public:
-    Evaluator() = default;
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    using objective_type = Objective;
+    using DomainTable    = std::conditional_t<Objective::uses_domain, ColorInDomainTable, NoDomainTable>;
+
+    BasicEvaluator() = default;
+    explicit BasicEvaluator(const allocator_type &alloc) : col_color_num_table_(alloc), color_in_domain_table_(alloc) {}
     // 一级评估函数
-    explicit Evaluator(const LatinSquare &latin_square, const Solution &solution) : col_color_num_table_(solution), color_in_domain_table_(solution, latin_square) {}
+    explicit BasicEvaluator(const LatinSquare &latin_square, const Solution &solution, const allocator_type &alloc = {})
+        : latin_square_(&latin_square), col_color_num_table_(solution, alloc), color_in_domain_table_(solution, latin_square, alloc) {}
+    // 就地重建评估器，复用已有内存；latin_square 须在评估器使用期间保持有效
+    void reset(const LatinSquare &latin_square, const Solution &solution) {
+        latin_square_ = &latin_square;
+        col_color_num_table_.set_table(solution);
+        color_in_domain_table_.set_table(solution, latin_square);
+    }
+    void release() {
+        col_color_num_table_.release();
+        color_in_domain_table_.release();
+    }
+    // 解除对拉丁方的引用（记录表内存保留），再次使用前须 reset
+    void detach() {
+        latin_square_ = nullptr;
+        color_in_domain_table_.detach();
+    }
     [[nodiscard]] int evaluate_conflict_delta(const Solution &solution, const Move &move) const { return col_color_num_table_.get_move_delta(solution, move); }
     // 二级评估函数
     [[nodiscard]] int evaluate_domain_delta(const Solution &solution, const Move &move) const { return color_in_domain_table_.get_move_delta(solution, move); }
-    // 对评估器进行更新，需要在对 solution 进行邻域动作之前
-    void update(const Solution &old_solution, const Move &move) {
-        col_color_num_table_.make_move(old_solution, move);
+    // 对评估器进行更新，需要在对 solution 进行邻域动作之前；返回受影响的 (颜色, 列) 对
+    ColColorNumTable::AffectedCells update(const Solution &old_solution, const Move &move) {
         color_in_domain_table_.make_move(old_solution, move);
+        return col_color_num_table_.make_move(old_solution, move);
     }
 
-    [[nodiscard]] bool is_conflict_grid(int color, int j) const { return col_color_num_table_.table_[color][j].size() > 1; }
+    [[nodiscard]] bool is_conflict_grid(int color, int j) const { return col_color_num_table_.is_conflict_grid(color, j); }
+
+    // 在第 j 列使用 color 颜色的格子数
+    [[nodiscard]] int color_count(int color, int j) const { return col_color_num_table_.get_rows(color, j).size(); }
+
+    // 最近一次 reset 或构造时的拉丁方
+    [[nodiscard]] const LatinSquare &latin_square() const { return *latin_square_; }
 
 private:
+    const LatinSquare *latin_square_{nullptr};
     ColColorNumTable col_color_num_table_;
-    ColorInDomainTable color_in_domain_table_;
+    [[no_unique_address]] DomainTable color_in_domain_table_;
 };
 
+// 目标策略在构建时选择（QM_PRIMARY_OBJECTIVE_ONLY），全部搜索引擎共用
+#ifdef QM_PRIMARY_OBJECTIVE_ONLY
+#ifdef COMPARE_DOMAIN_CONFLICTS
+#error "COMPARE_DOMAIN_CONFLICTS requires the domain tie-break objective"
+#endif
+using Evaluator = BasicEvaluator<PrimaryOnly>;
+#else
+using Evaluator = BasicEvaluator<DomainTieBreak>;
+#endif
+
 }// namespace qm::latin_square
 #endif// LATINSQUARECOMPLETION_EVALUATOR_H
@@ -0,0 +1,115 @@
+/**
+ * @file exact_search.h
+ * @brief 精确回溯引擎：在颜色域化简后剩余的非固定格上做深度优先搜索，能找到可行解或证明无解
+ *
+ * - 每行、每列已用颜色各用一个位掩码表示，格子的候选颜色 = 颜色域 & ~行已用 & ~列已用；
+ * - 变量选择：候选颜色最少的格子优先（MRV），候选数相同时取颜色域（Domain::size）较小者；
+ * - 前向检查：赋值后检查同行、同列的未赋值格，任一格没有候选颜色、或该行/列中某个尚未使用的颜色
+ *   已无处可放时立即回溯。
+ * 适合规模小或化简后非固定格很少的实例，也可以在 Solver 中先以有限的节点数试一次。
+ */
+
+#ifndef LATINSQUARECOMPLETION_EXACT_SEARCH_H
+#define LATINSQUARECOMPLETION_EXACT_SEARCH_H
+
+#include "latin_square/color_domain.h"
+#include "latin_square/engine.h"
+#include "latin_square/latin_square.h"
+#include "latin_square/telemetry.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 精确搜索参数
+ */
+struct ExactConfig {
+    int auto_max_free_cells             = 200;   // Solver 使用其它引擎时，非固定格不多于该值则先用精确搜索试一次，0 表示不试
+    unsigned long long auto_node_budget = 200000;// 先试时的节点数上限
+    double auto_time_fraction           = 0.1;   // 先试时最多占用总时间限制的比例，其余时间留给选定的引擎
+    bool verbose                        = true;  // 是否向 std::clog 输出搜索结果
+};
+
+// 精确搜索的结论
+enum class ExactStatus {
+    UNKNOWN,   // 达到节点上限、时间限制或被停止
+    SOLVED,    // 找到可行解
+    INFEASIBLE,// 已穷尽搜索空间，实例无解
+};
+
+class ExactSearch : public SearchEngine {
+public:
+    explicit ExactSearch(const ExactConfig &config = {}) : config_(config) {}
+
+    ExactSearch(const ExactSearch &)            = delete;
+    ExactSearch &operator=(const ExactSearch &) = delete;
+
+    [[nodiscard]] std::string_view name() const override { return "exact"; }
+
+    /**
+     * @brief 从颜色域出发做完整的回溯搜索，solution 只作为未解出时的返回值
+     * @param max_iteration 搜索节点数上限
+     */
+    void search(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration = 0, double time_limit_seconds = 0) override;
+
+    void set_config(const ExactConfig &config) { config_ = config; }
+    [[nodiscard]] const ExactConfig &config() const { return config_; }
+
+    void set_improvement_callback(ImprovementCallback callback) override { on_improvement_ = std::move(callback); }
+    void set_stop_flag(const std::atomic<bool> *stop_flag) override { stop_flag_ = stop_flag; }
+
+    [[nodiscard]] const Solution &best_solution() const override { return best_solution_; }
+    // 搜索节点数（尝试过的赋值数）
+    [[nodiscard]] unsigned long long iteration() const override { return nodes_; }
+    [[nodiscard]] const SearchTelemetry &telemetry() const override { return telemetry_; }
+
+    [[nodiscard]] ExactStatus status() const { return status_; }
+
+    // 颜色域化简后的非固定格数
+    [[nodiscard]] static int free_cells(const LatinSquare &latin_square);
+
+private:
+    static constexpr int WORDS = (ColorDomain::MAX_SET_SIZE + 63) / 64;
+    using Mask                 = std::array<std::uint64_t, WORDS>;
+
+    ExactConfig config_;
+    ImprovementCallback on_improvement_;
+    const std::atomic<bool> *stop_flag_{nullptr};
+    SearchTelemetry telemetry_;
+    ExactStatus status_{ExactStatus::UNKNOWN};
+    unsigned long long nodes_{};
+    unsigned long long max_nodes_{};
+    unsigned long long next_check_{};// 下一次检查时间限制与停止标志时的节点数
+    std::chrono::high_resolution_clock::time_point start_time_;
+    double time_limit_seconds_{};
+    bool aborted_{false};
+    Solution best_solution_;
+
+    int N_{};
+    std::vector<int> grid_;        // grid_[row * N + col]: 颜色，-1 表示未赋值
+    std::vector<Mask> domain_;     // domain_[row * N + col]: 颜色域
+    std::vector<int> domain_size_; // 颜色域大小（MRV 平局时的次级键）
+    std::vector<Mask> row_used_;   // 每行已使用的颜色
+    std::vector<Mask> col_used_;   // 每列已使用的颜色
+    std::vector<int> free_;        // 未赋值的格子，[0, free_count_) 为未赋值部分
+    std::vector<int> free_slot_;   // free_slot_[cell]: 格子在 free_ 中的下标
+    int free_count_{};
+
+    // 初始化掩码；固定格之间冲突或初始前向检查失败时返回 false
+    bool prepare_(const LatinSquare &latin_square);
+    [[nodiscard]] Mask candidates_(int cell) const;
+    [[nodiscard]] bool forward_check_(int row, int col) const;
+    void assign_(int cell, int color);
+    void unassign_(int cell, int color);
+    bool dfs_();
+    [[nodiscard]] bool out_of_budget_();
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_EXACT_SEARCH_H
@@ -0,0 +1,50 @@
+/**
+ * @file incremental.h
+ * @brief 固定格变化后的增量重解：在新实例上修复旧解，作为搜索的热启动初始解
+ *
+ * 旧解的每一行已是 0..n-1 的排列，修复只在行内交换：对每个值不符的固定格，
+ * 把该行中持有所需颜色的格子与它交换，交换次数等于值不符的固定格数，其余格子保持原样。
+ * 变化很少时修复后的方阵只有少量冲突，搜索从这里继续所需的迭代与变化规模相当。
+ */
+
+#ifndef LATINSQUARECOMPLETION_INCREMENTAL_H
+#define LATINSQUARECOMPLETION_INCREMENTAL_H
+
+#include "latin_square/instance.h"
+#include "latin_square/latin_square.h"
+
+#include <iosfwd>
+#include <vector>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 固定格的变化
+ */
+struct InstanceDelta {
+    std::vector<Assignment> added;  // 新增或改值的固定格
+    std::vector<Assignment> removed;// 取消固定的格子（只看行列，忽略取值）
+};
+
+/**
+ * @brief 对实例应用变化：先删除 removed 中的格子，再加入 added（同一格子以 added 为准）
+ * @throw std::invalid_argument 坐标或取值超出范围
+ */
+[[nodiscard]] Instance apply_delta(const Instance &instance, const InstanceDelta &delta);
+
+/**
+ * @brief 在行内交换旧解的格子，使颜色域化简后的全部固定格取到固定值
+ * @param swaps 若非空，返回交换次数
+ * @throw std::invalid_argument 旧解规模与实例不符或某一行不是排列
+ */
+[[nodiscard]] Solution repair_solution(const LatinSquare &latin_square, const Solution &previous, int *swaps = nullptr);
+
+/**
+ * @brief 读取文本格式的解（n 行，每行 n 个整数）
+ * @throw std::runtime_error 数据不完整
+ */
+[[nodiscard]] Solution read_text_solution(std::istream &is, int n);
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_INCREMENTAL_H
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <iostream>
+#include <utility>
 
 namespace qm::latin_square {
 
@@ -17,6 +18,10 @@ namespace qm::latin_square {
 
     class Instance {
     public:
+        Instance() = default;
+
+        Instance(int n, std::vector<Assignment> fixed) : n_(n), fixed_(std::move(fixed)) {}
+
         [[nodiscard]] int size() const { return n_; }
 
         [[nodiscard]] const std::vector<Assignment> &get_fixed() const { return fixed_; }
@@ -0,0 +1,38 @@
+/**
+ * @file instance_features.h
+ * @brief 实例特征：规模、预填比例与颜色域化简后的统计量，供引擎选择使用
+ *
+ * 特征只依赖 LatinSquare 构造时已经完成的 ColorDomain::simplify，提取代价为 O(n^2)。
+ */
+
+#ifndef LATINSQUARECOMPLETION_INSTANCE_FEATURES_H
+#define LATINSQUARECOMPLETION_INSTANCE_FEATURES_H
+
+#include "latin_square/latin_square.h"
+
+#include <iosfwd>
+#include <vector>
+
+namespace qm::latin_square {
+
+struct InstanceFeatures {
+    int n{0};                         // 拉丁方规模
+    int preset_cells{0};              // 实例给出的预填格数
+    double fill_ratio{0};             // 预填比例 preset_cells / n^2
+    int fixed_cells{0};               // 化简后颜色域只剩一种颜色的格子数（ColorDomain::fixed_num）
+    int free_cells{0};                // 化简后的非固定格数
+    long long total_domain_size{0};   // 化简后所有格子颜色域大小之和
+    double mean_free_domain_size{0};  // 非固定格的平均颜色域大小，没有非固定格时为 0
+    std::vector<int> domain_histogram;// domain_histogram[k]: 颜色域大小为 k 的格子数（k = 0..n）
+};
+
+[[nodiscard]] InstanceFeatures extract_features(const LatinSquare &latin_square);
+
+/**
+ * @brief 以单行 key=value 形式输出（直方图省略），便于日志检索
+ */
+std::ostream &operator<<(std::ostream &os, const InstanceFeatures &features);
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_INSTANCE_FEATURES_H
@@ -7,8 +7,12 @@
 #include "color_domain.h"
 #include "latin_square/instance.h"
 #include "latin_square/move.h"
+#include "latin_square/zobrist.h"
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <utility>
+#include <vector>
 
 namespace qm::latin_square {
 struct Solution {
@@ -16,6 +20,7 @@ struct Solution {
     int column_conflict{};
     int total_conflict{}; // 一级评估
     int domain_conflict{};// 二级评估
+    std::uint64_t hash{}; // 方阵的 Zobrist 哈希（见 zobrist.h），随移动增量维护
     std::vector<std::vector<int>> solution;
 
     Solution()                            = default;
@@ -24,15 +29,21 @@ struct Solution {
     Solution &operator=(const Solution &) = default;
     Solution &operator=(Solution &&)      = default;
 
-    explicit Solution(std::vector<std::vector<int>> solution) : solution(std::move(solution)) { calculate_conflict(); }
+    explicit Solution(std::vector<std::vector<int>> solution) : solution(std::move(solution)) {
+        calculate_conflict();
+        calculate_hash();
+    }
 
     [[nodiscard]] int get_color(const int row, const int col) const { return solution[row][col]; }
 
     void make_move(const Move &move) {
+        hash ^= zobrist::swap_delta(move.row_id, move.col1, move.col2, solution[move.row_id][move.col1], solution[move.row_id][move.col2]);
         std::swap(solution[move.row_id][move.col1], solution[move.row_id][move.col2]);
         calculate_conflict();
     }
 
+    void calculate_hash() { hash = zobrist::hash(solution); }
+
     bool operator==(const Solution &other) const {
 #ifdef COMPARE_DOMAIN_CONFLICTS
         return row_conflict == other.row_conflict &&
@@ -114,9 +125,15 @@ public:
     explicit LatinSquare(std::shared_ptr<Instance> instance) : instance_(std::move(instance)), color_domain_(instance_->size()) {
         for (const auto &assignment: instance_->get_fixed()) { color_domain_.set_fixed(assignment.row, assignment.col, assignment.num); }
         color_domain_.simplify();
+        build_free_index_();
     }
 
-    Solution generate_init_solution() { return Solution{color_domain_.get_initial_solution()}; }
+    Solution generate_init_solution() {
+        auto grid = color_domain_.get_initial_solution();
+        // 生成初始解前会再次化简颜色域，重建非固定格索引
+        build_free_index_();
+        return Solution{std::move(grid)};
+    }
 
     // 第 i 行 第 j 列 color 颜色是否在其颜色域内
     [[nodiscard]] bool color_in_domain(const int i, const int j, const int color) const { return color_domain_.is_valid(i, j, color); }
@@ -124,10 +141,48 @@ public:
     // 第 i 行 第 j 列是否被固定
     [[nodiscard]] bool is_fixed(const int i, const int j) const { return color_domain_(i, j).size == 1; }
 
+    // 第 row 行的非固定格列号（升序）
+    [[nodiscard]] std::span<const int> free_cols(const int row) const { return {free_cols_.data() + free_col_offsets_[row], free_cols_.data() + free_col_offsets_[row + 1]}; }
+
+    // 第 col 列的非固定格行号（升序）
+    [[nodiscard]] std::span<const int> free_rows(const int col) const { return {free_rows_.data() + free_row_offsets_[col], free_rows_.data() + free_row_offsets_[col + 1]}; }
+
+    // 非固定格总数
+    [[nodiscard]] int free_cell_count() const { return static_cast<int>(free_cols_.size()); }
+
     [[nodiscard]] int get_instance_size() const { return instance_->size(); }
 
     // private:
     std::shared_ptr<Instance> instance_;
     ColorDomain color_domain_;
+
+private:
+    // 非固定格的压缩行/列索引（CSR），颜色域化简后建立，搜索中的逐格遍历不再访问颜色域
+    std::vector<int> free_col_offsets_;
+    std::vector<int> free_cols_;
+    std::vector<int> free_row_offsets_;
+    std::vector<int> free_rows_;
+
+    void build_free_index_() {
+        const int N = instance_->size();
+        free_col_offsets_.assign(N + 1, 0);
+        free_row_offsets_.assign(N + 1, 0);
+        free_cols_.clear();
+        for (auto row = 0; row < N; ++row) {
+            for (auto col = 0; col < N; ++col) {
+                if (is_fixed(row, col)) { continue; }
+                free_cols_.push_back(col);
+                ++free_row_offsets_[col + 1];
+            }
+            free_col_offsets_[row + 1] = static_cast<int>(free_cols_.size());
+        }
+        for (auto col = 0; col < N; ++col) { free_row_offsets_[col + 1] += free_row_offsets_[col]; }
+        // 按行号升序填入各列
+        free_rows_.resize(free_cols_.size());
+        std::vector<int> next(free_row_offsets_.begin(), free_row_offsets_.end() - 1);
+        for (auto row = 0; row < N; ++row) {
+            for (const auto col: free_cols(row)) { free_rows_[next[col]++] = row; }
+        }
+    }
 };
 }// namespace qm::latin_square
\ No newline at end of file
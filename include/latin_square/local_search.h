@@ -5,81 +5,268 @@
 #ifndef LATINSQUARECOMPLETION_LOCAL_SEARCH_H
 #define LATINSQUARECOMPLETION_LOCAL_SEARCH_H
 
+#include "latin_square/checkpoint.h"
+#include "latin_square/engine.h"
 #include "latin_square/evaluator.h"
 #include "latin_square/latin_square.h"
 #include "latin_square/move.h"
+#include "latin_square/path_relinking.h"
+#include "latin_square/perturbation.h"
+#include "latin_square/row_conflict_grid.h"
+#include "latin_square/search_workspace.h"
+#include "latin_square/tabu_tenure.h"
+#include "latin_square/telemetry.h"
 #include "latin_square/vec_set.h"
+#include "latin_square/visited_set.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace qm::latin_square {
 
+/**
+ * @brief 大规模实例的候选列表参数
+ * @details 规模不小于 min_n 时，find_move 只评估按 (颜色, 列) 计数加权抽样的 sample_size 个冲突格所参与的交换，
+ *          抽样邻域中没有改进移动时回退到完整邻域扫描
+ */
+struct CandidateListConfig {
+    int min_n       = 80;// 启用候选列表的最小规模（实例规模上限为 ColorDomain::MAX_SET_SIZE）
+    int sample_size = 48;// 每次迭代抽样的冲突格数，不大于 0 表示关闭
+};
+
+/**
+ * @brief 禁忌搜索参数
+ */
+struct SearchConfig {
+    double tabu_alpha            = 0.4; // 禁忌期 = tabu_alpha * 当前冲突数 + randomInt(tabu_random_range)，反应式控制时为初值
+    int tabu_random_range        = 10;  // 禁忌期随机部分的取值范围，反应式控制时为初值
+    int restart_threshold        = 10;  // 重启阈值 rt 的初值：当前解比历史最优解差超过 rt 时重启
+    int restart_threshold_upper  = 15;  // 重启阈值上限 rtub
+    int restart_accumulate_upper = 1000;// 每累计 accub 次重启，重启阈值加一
+    bool verbose                 = true;// 是否向 std::clog 输出搜索进度
+    PerturbationConfig perturbation;    // 重启时的扰动参数
+    PathRelinkingConfig relinking;      // 重启时精英解之间的路径重连参数
+    TenureConfig tenure;                // 反应式禁忌期参数
+    CandidateListConfig candidates;     // 大规模实例的候选列表参数
+};
+
+/**
+ * @brief 检查点回调，在搜索线程内同步调用；参数仅在回调期间有效
+ */
+using CheckpointCallback = std::function<void(const SearchCheckpoint &checkpoint)>;
+
+/**
+ * @brief 禁忌表：记录 (行, 列, 颜色) 的禁忌到期迭代次数
+ * @details 按 [行][颜色][列] 排列，同一行的表项连续存放，find_move 逐行扫描时只访问一行的数据。
+ *          表项为相对基准 base_ 的 32 位到期值，绝对到期迭代次数为 base_ + 表项；
+ *          clear_tabu 把基准移到使全部已有表项都已到期的位置，代价为 O(1)。
+ *          相对值即将超出 32 位时重新以较新的基准换算全部表项（约每 2^31 次迭代一次）。
+ *          检查点中的下标仍按 i * N*N + j * N + color 编排，与布局无关。
+ */
 class TabuList {
 public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
     TabuList() = default;
 
-    explicit TabuList(int N) : N_(N) {
-        // 初始化一维数组，大小为 N * N * N
-        tabu_list_.resize(N * N * N, 0);
+    explicit TabuList(const allocator_type &alloc) : tabu_list_(alloc) {}
+
+    explicit TabuList(int N, const allocator_type &alloc = {}) : tabu_list_(alloc) { reset(N); }
+
+    // 调整规模并清空禁忌状态，复用已有容量
+    void reset(int N) {
+        N_ = N;
+        tabu_list_.assign(static_cast<size_t>(N) * N * N, 0);
+        base_      = 0;
+        max_entry_ = 0;
     }
 
+    // 归还禁忌表占用的内存
+    void release() { std::pmr::vector<std::uint32_t>(tabu_list_.get_allocator()).swap(tabu_list_); }
+
     [[nodiscard]] bool is_tabu(int i, int j, int color, unsigned long long current_iteration) const {
         // 检查索引是否在有效范围内
         assert(i >= 0 && i < N_ && j >= 0 && j < N_ && color >= 0 && color < N_);
-
-        // 计算一维索引：i * (N*N) + j * N + color
-        const int index = i * N_ * N_ + j * N_ + color;
-        return current_iteration < tabu_list_[index];
+        return static_cast<long long>(current_iteration) < base_ + tabu_list_[index_(i, j, color)];
     }
 
     void make_tabu(int i, int j, int color, unsigned long long target_iteration) {
         // 检查索引是否在有效范围内
         assert(i >= 0 && i < N_ && j >= 0 && j < N_ && color >= 0 && color < N_);
+        if (static_cast<long long>(target_iteration) - base_ > MAX_ENTRY) { rebase_(static_cast<long long>(target_iteration) - MAX_TENURE); }
+        const auto entry                = static_cast<std::uint32_t>(static_cast<long long>(target_iteration) - base_);
+        tabu_list_[index_(i, j, color)] = entry;
+        max_entry_                      = std::max(max_entry_, entry);
+    }
 
-        // 计算一维索引：i * (N*N) + j * N + color
-        int index         = i * N_ * N_ + j * N_ + color;
-        tabu_list_[index] = target_iteration;
+    // 导出尚未到期的禁忌项：(一维下标, 到期迭代次数)；已到期的项与 0 等价，无需保存
+    void export_active(unsigned long long current_iteration, std::vector<std::pair<std::uint32_t, unsigned long long>> &out) const {
+        out.clear();
+        for (auto i = 0; i < N_; ++i) {
+            for (auto j = 0; j < N_; ++j) {
+                for (auto color = 0; color < N_; ++color) {
+                    const long long target_iteration = base_ + tabu_list_[index_(i, j, color)];
+                    if (target_iteration > static_cast<long long>(current_iteration)) {
+                        out.emplace_back(static_cast<std::uint32_t>((i * N_ + j) * N_ + color), static_cast<unsigned long long>(target_iteration));
+                    }
+                }
+            }
+        }
     }
 
-    void clear_tabu() {
-        // 重置所有禁忌状态为0（非禁忌）
-        std::ranges::fill(tabu_list_, 0);
+    // 按规模 N 清空后写入导出的禁忌项
+    void restore(int N, const std::vector<std::pair<std::uint32_t, unsigned long long>> &entries) {
+        reset(N);
+        for (const auto &[index, target_iteration]: entries) {
+            if (index >= tabu_list_.size()) { throw std::out_of_range("tabu entry out of range"); }
+            const int color = static_cast<int>(index % N);
+            const int j     = static_cast<int>(index / N % N);
+            const int i     = static_cast<int>(index / N / N);
+            make_tabu(i, j, color, target_iteration);
+        }
     }
 
+    // 使全部禁忌项到期：移动基准使最大表项恰好在当前迭代到期，其余表项随之到期
+    void clear_tabu(unsigned long long current_iteration) { base_ = static_cast<long long>(current_iteration) - max_entry_; }
+
     // 获取底层数组大小的方法
     [[nodiscard]] int size() const { return N_; }
 
     // 获取内存使用情况（字节）
-    [[nodiscard]] size_t memory_usage() const { return tabu_list_.size() * sizeof(unsigned long long); }
+    [[nodiscard]] size_t memory_usage() const { return tabu_list_.size() * sizeof(std::uint32_t); }
 
 private:
+    static constexpr long long MAX_ENTRY  = std::numeric_limits<std::uint32_t>::max();
+    static constexpr long long MAX_TENURE = 1LL << 31;// 禁忌期上限，重新换算时保留的余量
+
     int N_{};// 问题规模
-    // 一维数组表示三维结构：tabu_list_[i * N*N + j * N + color] = target_iteration
-    std::vector<unsigned long long> tabu_list_;
+    // tabu_list_[(i * N + color) * N + j] = 到期迭代次数 - base_
+    std::pmr::vector<std::uint32_t> tabu_list_;
+    long long base_{0};          // 表项的基准迭代次数，清空后可能为负
+    std::uint32_t max_entry_{0}; // 全部表项的上界
+
+    [[nodiscard]] size_t index_(int i, int j, int color) const { return (static_cast<size_t>(i) * N_ + color) * N_ + j; }
+
+    // 以 new_base 为基准重新换算全部表项，早于新基准到期的表项记为 0（已到期）
+    void rebase_(long long new_base) {
+        max_entry_ = 0;
+        for (auto &entry: tabu_list_) {
+            const long long target_iteration = base_ + entry;
+            entry                            = target_iteration > new_base ? static_cast<std::uint32_t>(target_iteration - new_base) : 0;
+            max_entry_                       = std::max(max_entry_, entry);
+        }
+        base_ = new_base;
+    }
 };
 
-class LocalSearch {
+class LocalSearch : public SearchEngine {
 public:
-    void search(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration = 0, int time_limit_seconds = 0);
-    
+    explicit LocalSearch(const SearchConfig &config = {})
+        : config_(config), tabu_list_(workspace_.resource()), evaluator_(workspace_.resource()), row_grid_(workspace_.resource()) {}
+
+    LocalSearch(const LocalSearch &)            = delete;
+    LocalSearch &operator=(const LocalSearch &) = delete;
+
+    [[nodiscard]] std::string_view name() const override { return "tabu"; }
+
+    /**
+     * @brief 从给定初始解开始搜索
+     * @param max_iteration 最大迭代次数
+     * @param time_limit_seconds 时间限制（秒），不大于 0 表示不限时
+     */
+    void search(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration = 0, double time_limit_seconds = 0) override;
+
+    /**
+     * @brief 从检查点恢复搜索状态并继续搜索，轨迹与未中断的搜索逐位一致
+     * @param max_iteration 最大迭代次数（与迭代计数器比较，计数器从检查点继续）
+     * @param time_limit_seconds 本次运行的时间限制（秒），不大于 0 表示不限时
+     * @throw std::runtime_error 检查点与实例不匹配或内容不一致
+     */
+    void resume(const LatinSquare &latin_square, const SearchCheckpoint &checkpoint, unsigned long long max_iteration = 0, double time_limit_seconds = 0);
+
+    /**
+     * @brief 设置检查点回调：搜索中每隔 interval_seconds 秒调用一次，
+     *        搜索因时间限制、迭代上限或停止标志结束（未找到可行解）时再调用一次
+     */
+    void set_checkpoint_callback(CheckpointCallback callback, double interval_seconds) {
+        on_checkpoint_       = std::move(callback);
+        checkpoint_interval_ = interval_seconds;
+    }
+
+    void set_config(const SearchConfig &config) { config_ = config; }
+    [[nodiscard]] const SearchConfig &config() const { return config_; }
+
+    void set_improvement_callback(ImprovementCallback callback) override { on_improvement_ = std::move(callback); }
+
+    /**
+     * @brief 设置外部停止标志，标志置位后搜索在当前迭代结束时返回
+     */
+    void set_stop_flag(const std::atomic<bool> *stop_flag) override { stop_flag_ = stop_flag; }
+
+    [[nodiscard]] const Solution &best_solution() const override { return best_solution_; }
+
+    [[nodiscard]] unsigned long long iteration() const override { return iteration_; }
+
+    // 本次运行（search 或 resume 开始以来）的遥测计数
+    [[nodiscard]] const SearchTelemetry &telemetry() const override { return telemetry_; }
+
+    // 工作区（禁忌表、记录表、冲突节点集合所在的内存竞技场）
+    [[nodiscard]] const SearchWorkspace &workspace() const { return workspace_; }
+
     Solution best_solution_;  // 公开最优解，供外部访问
 
 private:
+    // 工作区必须先于从中分配内存的成员构造、后于它们析构
+    SearchWorkspace workspace_;
+    SearchConfig config_;
+    ImprovementCallback on_improvement_;
+    const std::atomic<bool> *stop_flag_{nullptr};
+    CheckpointCallback on_checkpoint_;
+    double checkpoint_interval_{0};
+    SearchCheckpoint checkpoint_;// 复用的检查点缓冲
+    double elapsed_offset_{0};   // 恢复前已累计的搜索时间
+    Perturbation perturbation_;
+    bool improved_since_restart_{false};// 上一次重启以来历史最优解是否严格改进
+    ElitePool elites_;                  // 重启时收集的精英解
+    PathRelinking relinking_;
+    int restarts_since_relink_{0};      // 上一次路径重连以来的重启次数
+    TabuTenureController tenure_;
+    VisitedSet visited_;// 最近访问过的解哈希，驱动禁忌期控制器的重访检测
+    SearchTelemetry telemetry_;
     unsigned long long iteration_{};
     Solution current_solution_;
     TabuList tabu_list_;
     Evaluator evaluator_;
-    std::vector<VecSet> row_conflict_grid_;
-    std::vector<VecSet> row_nonconflict_grid_;
+    RowConflictGrid row_grid_;
     int rt{};
     int accu{};
+    // 候选列表的抽样缓冲：全部冲突格 (行, 列) 及其累计权重、抽中的冲突格、本次迭代是否已抽中
+    std::vector<std::pair<int, int>> candidate_cells_;
+    std::vector<int> candidate_weights_;
+    std::vector<std::pair<int, int>> candidate_sample_;
+    std::vector<unsigned long long> candidate_stamp_;
+    void run_(const LatinSquare &latin_square, unsigned long long max_iteration, double time_limit_seconds);
+    void emit_checkpoint_(const LatinSquare &latin_square, double elapsed_seconds);
+    bool update_best_();
+    void reset_visited_();
+    void perturb_(const LatinSquare &latin_square);
+    // 收集精英解，到期时以路径重连得到的中间解作为重启起点；返回是否已设置好当前解
+    bool relink_(const LatinSquare &latin_square);
     Move find_move();
+    // 按 (颜色, 列) 计数加权抽样冲突格到 candidate_sample_；冲突格不多于抽样数时返回 false
+    bool sample_candidates_();
     void make_move(const Move &move);
-    void set_row_conflict_grid_(const Solution &solution);
-    void update_row_conflict_grid_incremental_(const std::vector<ColColorNumTable::AffectedCell> &affected_cells);
+    void prepare_workspace_(int N);
     [[nodiscard]] bool is_tabu(const Move &move, int conflict_num) const;
     void set_tabu(const Move &move);
-    
-    // for debug
-    void verify_conflict_grid() const;
 
     // for debug
     void check_solution_conflict_number() const {
@@ -113,7 +300,9 @@ private:
         if (total_conflict != current_solution_.total_conflict) {
             throw std::runtime_error("冲突边个数计算错误");
         }
-        auto &domain        = evaluator_.color_in_domain_table_.latin_square_.color_domain_;
+        // PrimaryOnly 不维护颜色域冲突数
+        if constexpr (!Evaluator::objective_type::uses_domain) { return; }
+        auto &domain        = evaluator_.latin_square().color_domain_;
         int domain_conflict = 0;
         for (auto i = 0; i < N; ++i) {
             for (auto j = 0; j < N; ++j) {
@@ -0,0 +1,93 @@
+/**
+ * @file memetic_search.h
+ * @brief 模因算法引擎：小种群 + 按行交叉 + 有界禁忌搜索改良 + 兼顾质量与距离的种群更新
+ *
+ * - 初始种群：第一个个体为给定初始解，其余由它施加随机的颜色域内行交换得到，随后各自改良；
+ * - 交叉：每一行整行取自两个父代之一（每行都是排列、固定格位置相同，交叉后仍满足行约束），
+ *   以一定概率优先取该行冲突格较少的父代；
+ * - 改良：每个子代运行一次迭代次数有界的 LocalSearch，同一代的子代在多个线程上并行改良，
+ *   每个子代使用由主线程随机数预先生成的种子，结果与线程调度无关；
+ * - 种群更新：与已有个体哈希相同的子代直接丢弃，否则加入后按
+ *   beta * 质量得分 + (1 - beta) * 距离得分 淘汰最差的个体（距离为到其它个体的最小 Hamming 距离）。
+ */
+
+#ifndef LATINSQUARECOMPLETION_MEMETIC_SEARCH_H
+#define LATINSQUARECOMPLETION_MEMETIC_SEARCH_H
+
+#include "latin_square/engine.h"
+#include "latin_square/latin_square.h"
+#include "latin_square/local_search.h"
+#include "latin_square/telemetry.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 模因算法参数
+ */
+struct MemeticConfig {
+    int population_size                       = 8;    // 种群规模
+    int threads                               = 0;    // 并行改良的线程数（即每代子代数），不大于 0 时取硬件并发数
+    unsigned long long improvement_iterations = 50000;// 每次改良的禁忌搜索迭代上限
+    double greedy_rows                        = 0.5;  // 交叉时每行取冲突较少的父代的概率，其余随机取
+    double quality_weight                     = 0.6;  // 种群更新中质量得分的权重 beta
+    bool verbose                              = true; // 是否向 std::clog 输出每代的进度
+    SearchConfig search;                              // 改良使用的禁忌搜索参数（不输出进度）
+};
+
+class MemeticSearch : public SearchEngine {
+public:
+    explicit MemeticSearch(const MemeticConfig &config = {}) : config_(config) {}
+
+    MemeticSearch(const MemeticSearch &)            = delete;
+    MemeticSearch &operator=(const MemeticSearch &) = delete;
+
+    [[nodiscard]] std::string_view name() const override { return "memetic"; }
+
+    void search(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration = 0, double time_limit_seconds = 0) override;
+
+    void set_config(const MemeticConfig &config) { config_ = config; }
+    [[nodiscard]] const MemeticConfig &config() const { return config_; }
+
+    void set_improvement_callback(ImprovementCallback callback) override { on_improvement_ = std::move(callback); }
+    void set_stop_flag(const std::atomic<bool> *stop_flag) override { stop_flag_ = stop_flag; }
+
+    [[nodiscard]] const Solution &best_solution() const override { return best_solution_; }
+    // 所有改良中禁忌搜索迭代次数之和
+    [[nodiscard]] unsigned long long iteration() const override { return iteration_; }
+    [[nodiscard]] const SearchTelemetry &telemetry() const override { return telemetry_; }
+
+    [[nodiscard]] const std::vector<Solution> &population() const { return population_; }
+
+private:
+    MemeticConfig config_;
+    ImprovementCallback on_improvement_;
+    const std::atomic<bool> *stop_flag_{nullptr};
+    SearchTelemetry telemetry_;
+    unsigned long long iteration_{};
+    Solution best_solution_;
+    std::vector<Solution> population_;
+    std::vector<std::vector<int>> distance_;           // 种群个体两两之间的 Hamming 距离
+    std::vector<std::unique_ptr<LocalSearch>> workers_;// 每个线程一个常驻的禁忌搜索
+
+    void prepare_workers_(int threads);
+    /**
+     * @brief 并行改良一批解，结果就地写回
+     * @param time_limit_seconds 每次改良的时间限制，0 表示不限时
+     */
+    void improve_(const LatinSquare &latin_square, std::vector<Solution> &batch, double time_limit_seconds);
+    [[nodiscard]] Solution diversify_(const LatinSquare &latin_square, const Solution &solution) const;
+    [[nodiscard]] Solution crossover_(const Solution &parent1, const Solution &parent2) const;
+    [[nodiscard]] int select_parent_(int excluded) const;
+    // 按质量与距离更新种群，返回子代是否被接纳
+    bool update_population_(Solution &&offspring);
+    bool update_best_(const Solution &solution);
+    [[nodiscard]] bool stop_requested_() const;
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_MEMETIC_SEARCH_H
@@ -0,0 +1,90 @@
+/**
+ * @file path_relinking.h
+ * @brief 精英解之间的路径重连：从一个精英解出发，逐步把与引导解不同的格子改成引导解的颜色
+ *
+ * - 精英池：重启时把历史最优解（同一冲突数下最近到达的那个）放入容量有限的池中，哈希相同的解不重复加入，
+ *   池满时替换冲突数最多的成员（相同时替换与新解 Hamming 距离最近的）；
+ * - 选对：在池中取 Hamming 距离最大的一对，距离用 SIMD 逐行比较（AVX2 / SSE2，其它平台退回标量）；
+ * - 重连：每步在所有不同的格子中，选择“把该格交换成引导解颜色”的行内交换里冲突数增量最小者
+ *   （相同时比较颜色域冲突增量，再相同时随机），用 Evaluator 增量评估并施加；
+ *   返回离两端都至少 min_steps 步的中间解中最好的一个，作为重启的起点。
+ *   精英解之间的距离通常有上千格，路径中段比两端差上百个冲突，因此只要求离两端走出固定步数。
+ */
+
+#ifndef LATINSQUARECOMPLETION_PATH_RELINKING_H
+#define LATINSQUARECOMPLETION_PATH_RELINKING_H
+
+#include "latin_square/evaluator.h"
+#include "latin_square/latin_square.h"
+#include "latin_square/move.h"
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 路径重连参数
+ */
+struct PathRelinkingConfig {
+    bool enabled     = false;// 关闭时重启只使用扰动（默认关闭，实测收益随实例而异）
+    int elite_size   = 8;    // 精英池容量
+    int period       = 10;   // 每隔多少次重启做一次路径重连（其余重启仍使用扰动）
+    int min_steps    = 10;   // 返回的中间解离两端都至少走过的步数
+};
+
+/**
+ * @brief 两个同规模方阵中颜色不同的格子数
+ */
+[[nodiscard]] int hamming_distance(const Solution &a, const Solution &b);
+
+class ElitePool {
+public:
+    explicit ElitePool(const int capacity = 8) : capacity_(capacity) {}
+
+    void set_capacity(int capacity);
+    [[nodiscard]] int capacity() const { return capacity_; }
+
+    void clear() { members_.clear(); }
+
+    /**
+     * @brief 尝试加入一个精英解
+     * @return 是否加入（哈希重复或比池中所有成员都差时不加入）
+     */
+    bool offer(const Solution &solution);
+
+    // Hamming 距离最大的一对成员的下标；成员少于两个时为空
+    [[nodiscard]] std::optional<std::pair<int, int>> most_distant_pair() const;
+
+    [[nodiscard]] const std::vector<Solution> &members() const { return members_; }
+    [[nodiscard]] int size() const { return static_cast<int>(members_.size()); }
+
+    // 按顺序替换全部成员（检查点恢复用）
+    void restore(std::vector<Solution> members) { members_ = std::move(members); }
+
+private:
+    int capacity_;
+    std::vector<Solution> members_;
+};
+
+class PathRelinking {
+public:
+    /**
+     * @brief 从 initiating 走向 guiding，返回路径上的最优中间解
+     * @param evaluator 用于增量评估的记录表，调用后处于任意状态，调用方需要重新 reset
+     * @param min_steps 返回的中间解离两端都至少走过的步数
+     * @return 两端距离过近（没有可取的中间解）或某行不是排列时为空
+     */
+    [[nodiscard]] std::optional<Solution> relink(const LatinSquare &latin_square, Evaluator &evaluator, const Solution &initiating, const Solution &guiding, int min_steps);
+
+private:
+    // 复用的缓冲
+    std::vector<std::vector<int>> position_;// position_[row][color]: 当前解中该行颜色所在的列
+    std::vector<int> differing_;            // 与引导解颜色不同的格子（row * N + col）
+    std::vector<int> slot_;                 // slot_[row * N + col]: 该格在 differing_ 中的下标，-1 表示相同
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_PATH_RELINKING_H
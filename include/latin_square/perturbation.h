@@ -0,0 +1,75 @@
+/**
+ * @file perturbation.h
+ * @brief 迭代禁忌搜索的扰动：重启回到历史最优解后，施加 k 次行内交换以跳出原来的盆地
+ *
+ * 交换分两类：冲突导向（从某行的冲突节点出发）与随机（任选某行两个非固定格），
+ * 两类都优先选择交换后两格颜色仍在各自颜色域内的移动。
+ * 强度 k 自适应：上一次重启后找到了更优解则回到最小强度，否则每连续 growth_period 次
+ * 未改进的重启强度加一，直至最大强度。
+ * 扰动只负责选择移动，移动由 LocalSearch::make_move 增量地施加到记录表与冲突节点集合上。
+ */
+
+#ifndef LATINSQUARECOMPLETION_PERTURBATION_H
+#define LATINSQUARECOMPLETION_PERTURBATION_H
+
+#include "latin_square/latin_square.h"
+#include "latin_square/move.h"
+#include "latin_square/row_conflict_grid.h"
+
+#include <vector>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 扰动参数
+ */
+struct PerturbationConfig {
+    bool enabled             = true;// 关闭时重启只回到历史最优解
+    int min_strength         = 0;   // 每次扰动的最少交换次数（0 表示刚改进后只回到历史最优解）
+    int max_strength         = 6;   // 每次扰动的最多交换次数
+    int growth_period        = 20;  // 连续多少次未改进的重启后强度加一
+    double conflict_directed = 0.7; // 每次交换为冲突导向的概率，其余为随机交换
+    int domain_attempts      = 8;   // 为找到颜色域内的交换最多尝试的次数
+};
+
+class Perturbation {
+public:
+    Perturbation() = default;
+    explicit Perturbation(const PerturbationConfig &config) : config_(config) {}
+
+    void set_config(const PerturbationConfig &config) {
+        config_ = config;
+        reset();
+    }
+    [[nodiscard]] const PerturbationConfig &config() const { return config_; }
+
+    // 回到最小强度（新一次搜索开始时调用）
+    void reset() { stagnation_ = 0; }
+
+    /**
+     * @brief 根据上一次重启以来是否改进了历史最优解调整强度，返回本次扰动的交换次数
+     */
+    int adapt(bool improved_since_last_restart);
+
+    [[nodiscard]] int strength() const;
+
+    // 连续未改进历史最优解的重启次数（检查点保存与恢复用）
+    [[nodiscard]] int stagnation() const { return stagnation_; }
+    void set_stagnation(int stagnation) { stagnation_ = stagnation; }
+
+    /**
+     * @brief 选择一次扰动交换
+     * @param grid 每行的冲突节点与非冲突节点（非固定格）
+     * @return 交换移动；找不到可交换的行时 row_id 为 -1
+     */
+    [[nodiscard]] Move propose(const LatinSquare &latin_square, const Solution &solution, const RowConflictGrid &grid);
+
+private:
+    PerturbationConfig config_;
+    int stagnation_{0};
+    std::vector<int> conflict_rows_;// 复用的有冲突行列表
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_PERTURBATION_H
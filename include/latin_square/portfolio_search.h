@@ -0,0 +1,81 @@
+/**
+ * @file portfolio_search.h
+ * @brief 并行组合引擎：多个引擎从同一初始解出发各占一个线程竞速，先找到可行解者获胜并停止其它成员
+ *
+ * 每个成员使用主线程预先生成的随机种子（随机数引擎为线程局部），结果与线程调度无关，
+ * 但哪个成员先结束取决于调度。历史最优解取所有成员中冲突数最少者。
+ * 改进回调在成员线程中调用，由互斥锁串行化，只在组合的最优冲突数严格下降时转发。
+ */
+
+#ifndef LATINSQUARECOMPLETION_PORTFOLIO_SEARCH_H
+#define LATINSQUARECOMPLETION_PORTFOLIO_SEARCH_H
+
+#include "latin_square/engine.h"
+#include "latin_square/latin_square.h"
+#include "latin_square/telemetry.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 并行组合的成员构成
+ */
+struct PortfolioConfig {
+    // 每个元素对应一个成员（可重复，同种引擎以不同种子运行），不能包含 PORTFOLIO 与 AUTO
+    std::vector<EngineKind> engines{EngineKind::TABU, EngineKind::TABU, EngineKind::ANNEALING};
+};
+
+class PortfolioSearch : public SearchEngine {
+public:
+    PortfolioSearch() = default;
+
+    PortfolioSearch(const PortfolioSearch &)            = delete;
+    PortfolioSearch &operator=(const PortfolioSearch &) = delete;
+
+    [[nodiscard]] std::string_view name() const override { return "portfolio"; }
+
+    // 加入一个成员；成员的改进回调与停止标志由组合在搜索时接管
+    void add_member(std::unique_ptr<SearchEngine> member) { members_.push_back(std::move(member)); }
+    void clear_members() { members_.clear(); }
+    [[nodiscard]] const std::vector<std::unique_ptr<SearchEngine>> &members() const { return members_; }
+
+    /**
+     * @brief 所有成员并行搜索，任一成员找到可行解或外部停止标志置位时停止全部成员
+     * @param max_iteration 每个成员各自的迭代上限
+     * @throw std::logic_error 没有成员
+     */
+    void search(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration, double time_limit_seconds) override;
+
+    void set_improvement_callback(ImprovementCallback callback) override { on_improvement_ = std::move(callback); }
+    void set_stop_flag(const std::atomic<bool> *stop_flag) override { stop_flag_ = stop_flag; }
+
+    [[nodiscard]] const Solution &best_solution() const override { return best_solution_; }
+    // 所有成员的迭代次数之和
+    [[nodiscard]] unsigned long long iteration() const override { return iteration_; }
+    // 最优成员的遥测
+    [[nodiscard]] const SearchTelemetry &telemetry() const override { return telemetry_; }
+
+    // 最优成员的名称（搜索前为空）
+    [[nodiscard]] const std::string &winner() const { return winner_; }
+
+private:
+    std::vector<std::unique_ptr<SearchEngine>> members_;
+    ImprovementCallback on_improvement_;
+    const std::atomic<bool> *stop_flag_{nullptr};
+    std::atomic<bool> finished_{false};// 有成员找到可行解或外部请求停止
+    std::mutex improvement_mutex_;
+    int reported_conflict_{0};// 已通过回调报告的最优冲突数
+    SearchTelemetry telemetry_;
+    unsigned long long iteration_{};
+    Solution best_solution_;
+    std::string winner_;
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_PORTFOLIO_SEARCH_H
@@ -0,0 +1,52 @@
+/**
+ * @file reduction.h
+ * @brief 问题收缩：去掉完全固定的行与列，把剩余部分映射为更小的拉丁方补全问题
+ *
+ * 设颜色域化简后完全固定的行集合为 R、列集合为 C。当 |R| = |C| = k（0 < k < n），
+ * 且每个剩余行在 C 上的颜色集合、每个剩余列在 R 上的颜色集合都等于同一个集合 S 时，
+ * 剩余的 (n-k) x (n-k) 子方阵恰好是颜色集合为 S 的补集的拉丁方补全问题：
+ * 把该补集按升序重新编号为 0..n-k-1 即得到子实例，子实例的解按映射填回即为原实例的解。
+ * 条件不满足时不收缩（搜索在完整方阵上进行，固定格本身不参与移动）。
+ */
+
+#ifndef LATINSQUARECOMPLETION_REDUCTION_H
+#define LATINSQUARECOMPLETION_REDUCTION_H
+
+#include "latin_square/instance.h"
+#include "latin_square/latin_square.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace qm::latin_square {
+
+class Reduction {
+public:
+    /**
+     * @brief 分析已化简颜色域的拉丁方，能收缩时返回子问题映射
+     */
+    [[nodiscard]] static std::optional<Reduction> analyze(const LatinSquare &latin_square);
+
+    // 子实例：剩余行列中的固定格，颜色已重新编号
+    [[nodiscard]] const std::shared_ptr<Instance> &instance() const { return instance_; }
+
+    [[nodiscard]] int original_size() const { return static_cast<int>(grid_.size()); }
+    [[nodiscard]] int reduced_size() const { return static_cast<int>(rows_.size()); }
+
+    /**
+     * @brief 把子实例上的方阵填回原规模方阵，冲突数与哈希按原方阵重新计算
+     */
+    [[nodiscard]] Solution lift(const Solution &reduced) const;
+
+private:
+    std::vector<int> rows_;             // 子实例行号 -> 原行号
+    std::vector<int> cols_;             // 子实例列号 -> 原列号
+    std::vector<int> colors_;           // 子实例颜色 -> 原颜色
+    std::vector<std::vector<int>> grid_;// 原方阵的固定颜色，剩余部分由 lift 填入
+    std::shared_ptr<Instance> instance_;
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_REDUCTION_H
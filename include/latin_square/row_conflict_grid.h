@@ -0,0 +1,73 @@
+/**
+ * @file row_conflict_grid.h
+ * @brief 冲突节点集合：按行记录非固定格中的冲突节点与非冲突节点，由各搜索引擎共用
+ *
+ * 冲突节点指该格颜色在所在列中出现不止一次的格子。集合随 ColColorNumTable 增量维护，
+ * 集合内元素的顺序会影响搜索的平局选择，因此更新顺序固定，检查点按原顺序保存与恢复。
+ */
+
+#ifndef LATINSQUARECOMPLETION_ROW_CONFLICT_GRID_H
+#define LATINSQUARECOMPLETION_ROW_CONFLICT_GRID_H
+
+#include "latin_square/evaluator.h"
+#include "latin_square/latin_square.h"
+#include "latin_square/vec_set.h"
+
+#include <memory_resource>
+#include <vector>
+
+namespace qm::latin_square {
+
+class RowConflictGrid {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    RowConflictGrid() = default;
+    explicit RowConflictGrid(const allocator_type &alloc) : conflict_(alloc), nonconflict_(alloc) {}
+
+    /**
+     * @brief 由当前解与记录表重建全部集合，规模不变时复用已有内存
+     */
+    void rebuild(const LatinSquare &latin_square, const Evaluator &evaluator, const Solution &solution);
+
+    /**
+     * @brief 移动施加后增量更新：只有交换的两列（affected_cells 中第 0、1 项）中的格子状态可能改变
+     * @warning 须在记录表与解都更新之后调用
+     */
+    void update(const LatinSquare &latin_square, const Evaluator &evaluator, const Solution &solution, const ColColorNumTable::AffectedCells &affected_cells);
+
+    /**
+     * @brief 按保存的元素顺序恢复集合，并校验与当前解一致
+     * @throw std::runtime_error 行数与规模不符、状态与当前解不一致或不完整
+     */
+    void restore(const LatinSquare &latin_square, const Evaluator &evaluator, const Solution &solution, const std::vector<std::vector<int>> &conflict,
+                 const std::vector<std::vector<int>> &nonconflict);
+
+    // 按元素顺序导出（检查点保存用）
+    void export_to(std::vector<std::vector<int>> &conflict, std::vector<std::vector<int>> &nonconflict) const;
+
+    // 与由当前解重新计算的结果比较（调试用）
+    void verify(const LatinSquare &latin_square, const Evaluator &evaluator, const Solution &solution) const;
+
+    // 归还占用的内存
+    void release() {
+        std::pmr::vector<VecSet>(conflict_.get_allocator()).swap(conflict_);
+        std::pmr::vector<VecSet>(nonconflict_.get_allocator()).swap(nonconflict_);
+    }
+
+    [[nodiscard]] const VecSet &conflict(int row) const { return conflict_[row]; }
+    [[nodiscard]] const VecSet &nonconflict(int row) const { return nonconflict_[row]; }
+
+    // 行内非固定格数
+    [[nodiscard]] int free_count(int row) const { return conflict_[row].size() + nonconflict_[row].size(); }
+
+    [[nodiscard]] int rows() const { return static_cast<int>(conflict_.size()); }
+
+private:
+    std::pmr::vector<VecSet> conflict_;   // conflict_[row]: 该行的冲突节点列号
+    std::pmr::vector<VecSet> nonconflict_;// nonconflict_[row]: 该行的非冲突节点列号（非固定格）
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_ROW_CONFLICT_GRID_H
@@ -0,0 +1,103 @@
+/**
+ * @file search_workspace.h
+ * @brief 搜索工作区：单块内存竞技场，供一次搜索中的禁忌表、记录表、冲突节点集合等结构切分使用
+ *
+ * 工作区按出现过的最大规模 n 分配一整块内存，规模不超过该值的后续求解直接复用，
+ * 批量与常驻服务模式下稳态求解不再产生堆分配。
+ */
+
+#ifndef LATINSQUARECOMPLETION_SEARCH_WORKSPACE_H
+#define LATINSQUARECOMPLETION_SEARCH_WORKSPACE_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 单调递增的内存竞技场
+ * @details 分配只移动指针，释放为空操作；块内空间不足时临时向上游申请并记录所需总量，
+ * 下一次 reset() 时将主块扩大到历史峰值，之后同等规模的使用不再回退到上游。
+ */
+class Arena : public std::pmr::memory_resource {
+public:
+    explicit Arena(std::size_t capacity = 0) { reserve(capacity); }
+    ~Arena() override { release_overflow(); }
+
+    Arena(const Arena &)            = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * @brief 归还所有已分配的内存，调用前必须保证没有对象仍在使用竞技场中的内存
+     */
+    void reset();
+
+    /**
+     * @brief 确保主块容量不小于 capacity；只能在竞技场为空（刚 reset）时调用
+     */
+    void reserve(std::size_t capacity);
+
+    [[nodiscard]] std::size_t capacity() const { return capacity_; }
+    [[nodiscard]] std::size_t used() const { return offset_ + overflow_bytes_; }
+    [[nodiscard]] std::size_t high_water() const { return high_water_; }
+    // 自上次 reset 以来回退到上游分配的次数，稳态下应为 0
+    [[nodiscard]] std::size_t overflow_count() const { return overflow_.size(); }
+
+private:
+    struct OverflowBlock {
+        void *ptr;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+
+    std::unique_ptr<std::byte[]> block_;
+    std::size_t capacity_{0};
+    std::size_t offset_{0};
+    std::size_t high_water_{0};
+    std::size_t overflow_bytes_{0};
+    std::vector<OverflowBlock> overflow_;
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *, std::size_t, std::size_t) override {}
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+    void release_overflow();
+};
+
+/**
+ * @brief 一次局部搜索所需的工作区
+ * @details needs_growth() 为真时，使用方必须先释放所有从工作区分配的结构，再调用 grow()
+ */
+class SearchWorkspace {
+public:
+    SearchWorkspace() = default;
+
+    [[nodiscard]] std::pmr::memory_resource *resource() { return &arena_; }
+    [[nodiscard]] const Arena &arena() const { return arena_; }
+
+    /**
+     * @brief 规模 n 是否超过了当前工作区能容纳的最大规模
+     */
+    [[nodiscard]] bool needs_growth(int n) const { return n > largest_order_; }
+
+    /**
+     * @brief 重置竞技场并按规模 n 扩容
+     */
+    void grow(int n);
+
+    [[nodiscard]] int largest_order() const { return largest_order_; }
+
+    /**
+     * @brief 估算规模为 n 的一次搜索需要的工作区字节数
+     */
+    [[nodiscard]] static std::size_t estimate_bytes(int n);
+
+private:
+    Arena arena_;
+    int largest_order_{0};
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_SEARCH_WORKSPACE_H
@@ -0,0 +1,99 @@
+/**
+ * @file server.h
+ * @brief 常驻求解服务：通过 Unix 域套接字或标准输入/输出接收分帧请求
+ *
+ * 每个工作线程持有一个常驻的 Solver（及其 LocalSearch 工作区），请求在有界队列中排队，
+ * 队列满时读取端阻塞形成背压。所有整数均为小端序，帧格式如下：
+ *
+ * 请求帧：u32 payload_size | u64 request_id | u32 deadline_ms | u32 seed | 实例记录（LSQI，见 binary_io.h）
+ * 响应帧：u32 payload_size | u64 request_id | u8 status | u8[3] 保留 | i32 conflicts | u64 iterations
+ *        | f64 elapsed_seconds | 解记录（LSQS，仅 status 为 SOLVED/BEST_EFFORT 时存在）或 UTF-8 错误信息
+ *
+ * deadline_ms 从服务端收到请求时开始计时（含排队时间），为 0 表示使用 ServerConfig 中的默认值。
+ * 同一连接上的响应按完成顺序返回，客户端通过 request_id 对应请求。
+ */
+
+#ifndef LATINSQUARECOMPLETION_SERVER_H
+#define LATINSQUARECOMPLETION_SERVER_H
+
+#include "latin_square/local_search.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace qm::latin_square {
+
+struct ServerConfig {
+    int workers                     = 0;        // 工作线程数，不大于 0 时取硬件并发数
+    std::size_t queue_capacity      = 64;       // 等待队列上限
+    double default_deadline_seconds = 10;       // 请求未指定截止时间时使用的时限
+    std::size_t max_frame_size      = 64u << 20;// 单帧最大字节数
+    SearchConfig search;                        // 禁忌搜索参数（服务模式下默认关闭进度输出）
+    std::string cache_dir;                      // 若非空，各工作线程共用该目录下的已解实例缓存
+    std::size_t cache_capacity = 10000;         // 缓存最多保留的条目数
+
+    ServerConfig() { search.verbose = false; }
+};
+
+enum class ResponseStatus : std::uint8_t {
+    SOLVED      = 0,// 找到可行解
+    BEST_EFFORT = 1,// 截止时间到，返回当前最优解
+    ERROR       = 2,// 请求格式错误或求解失败，负载为错误信息
+    EXPIRED     = 3,// 排队期间已超过截止时间，未开始求解
+};
+
+class WorkerPool;
+
+class SolverServer {
+public:
+    explicit SolverServer(const ServerConfig &config = {});
+    ~SolverServer();
+
+    SolverServer(const SolverServer &)            = delete;
+    SolverServer &operator=(const SolverServer &) = delete;
+
+    /**
+     * @brief 在一对文件描述符上处理分帧请求（例如标准输入/输出），读到 EOF 且所有请求完成后返回
+     */
+    void serve_stream(int in_fd, int out_fd);
+
+    /**
+     * @brief 监听 Unix 域套接字，直到 stop() 被调用
+     * @throw std::runtime_error 套接字创建、绑定或监听失败，或平台不支持
+     */
+    void serve_unix_socket(const std::string &path);
+
+    /**
+     * @brief 停止接受新连接并关闭现有连接的读取端，已排队的请求仍会完成
+     */
+    void stop();
+
+private:
+    struct Connection;
+
+    // 连接处理线程；finished 在线程函数返回前置位，接受新连接时回收已结束的线程
+    struct ConnectionThread {
+        std::thread thread;
+        std::shared_ptr<std::atomic<bool>> finished;
+    };
+
+    ServerConfig config_;
+    std::unique_ptr<WorkerPool> pool_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<int> listen_fd_{-1};
+    std::mutex connections_mutex_;
+    std::vector<std::weak_ptr<Connection>> connections_;
+    std::vector<ConnectionThread> connection_threads_;
+
+    void handle_connection(const std::shared_ptr<Connection> &connection);
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_SERVER_H
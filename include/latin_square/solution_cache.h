@@ -0,0 +1,59 @@
+/**
+ * @file solution_cache.h
+ * @brief 已解实例的磁盘缓存：以规范形式（canonical_form.h）为键，容量有界，按最近使用淘汰
+ *
+ * 每个条目是目录下的一个文件 "<规范哈希>.lsc"，依次存放规范实例记录与规范解记录（binary_io.h 格式）。
+ * 命中时比较完整的规范实例排除哈希碰撞，解经置换映射回原实例并校验后返回，同时刷新文件修改时间；
+ * 写入时先写临时文件再原子替换，超出容量时删除修改时间最早的条目。
+ * 多个线程或进程可以共用同一目录：读到的总是完整的条目，淘汰与写入的竞争只会让条目提前失效。
+ */
+
+#ifndef LATINSQUARECOMPLETION_SOLUTION_CACHE_H
+#define LATINSQUARECOMPLETION_SOLUTION_CACHE_H
+
+#include "latin_square/canonical_form.h"
+#include "latin_square/instance.h"
+#include "latin_square/latin_square.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+namespace qm::latin_square {
+
+class SolutionCache {
+public:
+    /**
+     * @param directory 缓存目录，不存在时创建
+     * @param capacity 最多保留的条目数
+     * @throw std::runtime_error 目录无法创建
+     */
+    SolutionCache(std::string directory, std::size_t capacity);
+
+    /**
+     * @brief 查找实例的解；条目缺失、损坏或映射回的解不可行时返回 std::nullopt
+     */
+    [[nodiscard]] std::optional<Solution> lookup(const Instance &instance) const;
+    [[nodiscard]] std::optional<Solution> lookup(const Instance &instance, const CanonicalForm &form) const;
+
+    /**
+     * @brief 保存可行解；写入失败不抛出异常，返回 false
+     */
+    bool store(const Instance &instance, const Solution &solution) const;
+    bool store(const CanonicalForm &form, const Solution &solution) const;
+
+    [[nodiscard]] const std::string &directory() const { return directory_; }
+    [[nodiscard]] std::size_t capacity() const { return capacity_; }
+
+private:
+    std::string directory_;
+    std::size_t capacity_;
+
+    [[nodiscard]] std::filesystem::path entry_path_(const CanonicalForm &form) const;
+    void evict_() const;
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_SOLUTION_CACHE_H
@@ -0,0 +1,55 @@
+/**
+ * @file solution_writer.h
+ * @brief 解的文本序列化：整张方阵格式化到一块预分配的缓冲区，再一次性写出
+ *
+ * 输出格式与原先逐行输出一致：n 行，每行 n 个以空格分隔的整数。
+ * 缓冲区在多次调用间复用，批量输出时不会重复分配内存。
+ */
+
+#ifndef LATINSQUARECOMPLETION_SOLUTION_WRITER_H
+#define LATINSQUARECOMPLETION_SOLUTION_WRITER_H
+
+#include "latin_square/latin_square.h"
+
+#include <cstdio>
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+
+namespace qm::latin_square {
+
+class SolutionWriter {
+public:
+    SolutionWriter() = default;
+
+    /**
+     * @brief 将解格式化到内部缓冲区
+     * @param solution 要输出的解
+     * @param trailing_blank_line 是否在末尾额外追加一个空行（用于分隔批量输出中的相邻解）
+     * @return 指向内部缓冲区的视图，在下一次 format 之前有效
+     */
+    std::string_view format(const Solution &solution, bool trailing_blank_line = false);
+
+    /**
+     * @brief 格式化并通过一次 write 调用写入输出流
+     */
+    void write(std::ostream &os, const Solution &solution, bool trailing_blank_line = false);
+
+    /**
+     * @brief 格式化并通过一次 fwrite 调用写入文件
+     * @throw std::runtime_error 写入失败
+     */
+    void write(std::FILE *file, const Solution &solution, bool trailing_blank_line = false);
+
+    /**
+     * @brief 格式化 n 阶解所需的最大字节数
+     */
+    [[nodiscard]] static std::size_t max_formatted_size(std::size_t n);
+
+private:
+    std::vector<char> buffer_;
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_SOLUTION_WRITER_H
@@ -0,0 +1,163 @@
+/**
+ * @file solver.h
+ * @brief 可嵌入的求解器接口：Instance -> LatinSquare -> 初始解 -> 局部搜索
+ *
+ * 供服务进程内直接调用，无需每个请求 fork/exec 一次命令行程序。
+ * 一个 Solver 对象可以反复求解多个实例，但同一时刻只能被一个线程使用。
+ */
+
+#ifndef LATINSQUARECOMPLETION_SOLVER_H
+#define LATINSQUARECOMPLETION_SOLVER_H
+
+#include "latin_square/annealing_search.h"
+#include "latin_square/checkpoint.h"
+#include "latin_square/engine_selector.h"
+#include "latin_square/exact_search.h"
+#include "latin_square/incremental.h"
+#include "latin_square/instance.h"
+#include "latin_square/latin_square.h"
+#include "latin_square/local_search.h"
+#include "latin_square/memetic_search.h"
+#include "latin_square/portfolio_search.h"
+#include "latin_square/reduction.h"
+#include "latin_square/solution_cache.h"
+#include "latin_square/weighting_search.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 求解器配置
+ */
+struct SolverConfig {
+    double time_limit_seconds         = 0;               // 时间限制（秒），不大于 0 表示不限时
+    unsigned long long max_iterations = 100000000000ULL; // 最大迭代次数
+    std::optional<unsigned> seed;                        // 若设置，则在求解前为当前线程重设随机种子
+    EngineKind engine = EngineKind::TABU;                // 搜索引擎
+    SearchConfig search;                                 // 禁忌搜索参数
+    WeightingConfig weighting;                           // 约束加权搜索参数
+    AnnealingConfig annealing;                           // 模拟退火参数
+    MemeticConfig memetic;                               // 模因算法参数
+    ExactConfig exact;                                   // 精确搜索参数（含其它引擎之前先试一次的阈值）
+    PortfolioConfig portfolio;                           // 并行组合的成员（成员不输出进度）
+    SelectorThresholds selector;                         // engine 为 AUTO 时的选择阈值
+    std::string cache_dir;                               // 若非空，在该目录下缓存已解实例（见 solution_cache.h）
+    std::size_t cache_capacity = 10000;                  // 缓存最多保留的条目数
+    bool shrink = true;                                  // 能收缩时在去掉完全固定行列的子问题上搜索（见 reduction.h），写检查点时不收缩
+    std::string checkpoint_path;                         // 若非空，定期把搜索状态写入该检查点文件
+    double checkpoint_interval_seconds = 300;            // 检查点写入间隔（秒）
+};
+
+/**
+ * @brief 求解结果
+ */
+struct SolverResult {
+    Solution solution;                 // 找到的最优解
+    int conflicts{0};                  // 最优解的冲突数，0 表示可行解
+    unsigned long long iterations{0};  // 局部搜索迭代次数
+    double elapsed_seconds{0};         // 求解总耗时（含初始化）
+    bool cancelled{false};             // 是否因取消而提前结束
+    bool infeasible{false};            // 精确搜索已证明实例无解
+    EngineKind engine{EngineKind::TABU};// 实际使用的引擎（AUTO 解析后的结果）
+    int reduced_size{0};               // 问题收缩后子实例的规模，未收缩为 0
+    bool cached{false};                // 解来自缓存，未进行搜索
+    int repair_swaps{-1};              // 热启动时修复旧解所用的行内交换次数，未热启动为 -1
+
+    [[nodiscard]] bool solved() const { return conflicts == 0; }
+};
+
+/**
+ * @brief 取消令牌，可在任意线程调用 cancel() 请求求解尽快返回
+ * @details 令牌的拷贝共享同一个标志
+ */
+class CancellationToken {
+public:
+    CancellationToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { flag_->store(true, std::memory_order_relaxed); }
+    void reset() const { flag_->store(false, std::memory_order_relaxed); }
+    [[nodiscard]] bool cancelled() const { return flag_->load(std::memory_order_relaxed); }
+    [[nodiscard]] const std::atomic<bool> *flag() const { return flag_.get(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+class Solver {
+public:
+    Solver() = default;
+    explicit Solver(const SolverConfig &config) : config_(config) {}
+
+    void set_config(const SolverConfig &config) { config_ = config; }
+    [[nodiscard]] const SolverConfig &config() const { return config_; }
+
+    /**
+     * @brief 设置改进回调，在最优解冲突数严格下降时调用（在求解线程内同步执行）
+     */
+    void set_improvement_callback(ImprovementCallback callback) { on_improvement_ = std::move(callback); }
+
+    SolverResult solve(std::shared_ptr<Instance> instance) { return solve(std::move(instance), nullptr); }
+    SolverResult solve(std::shared_ptr<Instance> instance, const CancellationToken &token) { return solve(std::move(instance), token.flag()); }
+
+    /**
+     * @brief 求解实例
+     * @param stop_flag 外部停止标志，可为空
+     */
+    SolverResult solve(std::shared_ptr<Instance> instance, const std::atomic<bool> *stop_flag);
+
+    /**
+     * @brief 以旧解热启动求解：旧解按新实例的固定格修复（repair_solution）后直接作为搜索的初始解
+     * @details 热启动时不做问题收缩，也不生成贪心初始解
+     * @throw std::invalid_argument 旧解规模与实例不符或某一行不是排列
+     */
+    SolverResult solve_from(std::shared_ptr<Instance> instance, const Solution &warm_start, const std::atomic<bool> *stop_flag = nullptr);
+
+    /**
+     * @brief 增量重解：对旧实例应用固定格变化，以旧解热启动求解新实例
+     */
+    SolverResult resolve(const Instance &previous_instance, const Solution &previous_solution, const InstanceDelta &delta, const std::atomic<bool> *stop_flag = nullptr) {
+        return solve_from(std::make_shared<Instance>(apply_delta(previous_instance, delta)), previous_solution, stop_flag);
+    }
+
+    /**
+     * @brief 从检查点继续求解，忽略配置中的随机种子（随机数状态来自检查点）
+     * @details 检查点只由禁忌搜索引擎产生，恢复时总是使用禁忌搜索
+     * @throw std::runtime_error 检查点与实例不匹配
+     */
+    SolverResult resume(std::shared_ptr<Instance> instance, const SearchCheckpoint &checkpoint, const std::atomic<bool> *stop_flag = nullptr);
+
+private:
+    SolverConfig config_;
+    ImprovementCallback on_improvement_;
+    LocalSearch local_search_;
+    std::unique_ptr<WeightingSearch> weighting_search_;// 首次选用时创建
+    std::unique_ptr<AnnealingSearch> annealing_search_;// 首次选用时创建
+    std::unique_ptr<MemeticSearch> memetic_search_;    // 首次选用时创建
+    std::unique_ptr<ExactSearch> exact_search_;        // 首次选用时创建
+    std::unique_ptr<PortfolioSearch> portfolio_search_;// 首次选用时创建，成员每次求解前重建
+
+    std::unique_ptr<SolutionCache> cache_;// 配置了缓存目录时创建，目录或容量改变时重建
+    // 带缓存查找与写入的求解入口
+    SolverResult solve_cached_(std::shared_ptr<Instance> instance, const Solution *warm_start, const std::atomic<bool> *stop_flag);
+    // 设置随机种子并开始计时，能收缩时转到 solve_reduced_，否则直接 search_
+    SolverResult solve_(std::shared_ptr<Instance> instance, const Solution *warm_start, const std::atomic<bool> *stop_flag);
+    // 在收缩后的子实例上求解，改进回调与结果都填回原规模
+    SolverResult solve_reduced_(const Reduction &reduction, const std::atomic<bool> *stop_flag, std::chrono::steady_clock::time_point start_time);
+    // 生成初始解（或修复热启动的旧解）并运行引擎；时间限制从 start_time 起算
+    SolverResult search_(LatinSquare &latin_square, const Solution *warm_start, const std::atomic<bool> *stop_flag, std::chrono::steady_clock::time_point start_time);
+    SearchEngine &prepare_engine_(EngineKind kind, const std::atomic<bool> *stop_flag);
+    // 并行组合的成员：使用 SolverConfig 中对应引擎的参数，关闭进度输出
+    [[nodiscard]] std::unique_ptr<SearchEngine> make_portfolio_member_(EngineKind kind) const;
+    void prepare_local_search_(const std::atomic<bool> *stop_flag);
+    ExactSearch &prepare_exact_search_(const std::atomic<bool> *stop_flag);
+    static SolverResult collect_result_(const SearchEngine &engine, const std::atomic<bool> *stop_flag, double elapsed_seconds);
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_SOLVER_H
@@ -0,0 +1,98 @@
+/**
+ * @file tabu_tenure.h
+ * @brief 反应式禁忌期控制器：在线调整禁忌期 = alpha * 当前冲突数 + randomInt(random_range) 中的两个参数
+ *
+ * - 循环检测：自上次调整以来当前解的 Zobrist 哈希命中最近访问过的状态（重访）累计达到
+ *   revisit_threshold 次，或最近的当前冲突数序列
+ *   对某个周期 p（2 <= p <= max_cycle_period）已连续重复 cycle_repeats 个周期，
+ *   则认为搜索在循环，增大 alpha 与 random_range；
+ * - 长期无循环：距上次检测到循环超过 decrease_interval 次迭代，减小 alpha 与 random_range；
+ * - 平台期：超过 plateau_length 次迭代未改进历史最优解，增大 random_range 以加强随机化。
+ * 所有调整都限制在配置的上下界内，并计入 SearchTelemetry。
+ */
+
+#ifndef LATINSQUARECOMPLETION_TABU_TENURE_H
+#define LATINSQUARECOMPLETION_TABU_TENURE_H
+
+#include "latin_square/telemetry.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 反应式禁忌期参数
+ */
+struct TenureConfig {
+    bool reactive                        = false; // 关闭时始终使用 SearchConfig 中的固定参数（默认关闭，实测收益不稳定）
+    double min_alpha                     = 0.4;   // alpha 下界（低于默认初值时实测明显变差）
+    double max_alpha                     = 1.2;   // alpha 上界
+    int min_random_range                 = 10;    // random_range 下界
+    int max_random_range                 = 40;    // random_range 上界
+    double increase_factor               = 1.2;   // 检测到循环时 alpha 的放大倍数
+    double decrease_factor               = 0.9;   // 长期无循环时 alpha 的缩小倍数
+    int random_range_step                = 2;     // random_range 每次调整的步长
+    int max_cycle_period                 = 48;    // 检测的最长循环周期
+    int cycle_repeats                    = 3;     // 判定为循环所需的连续重复周期数
+    unsigned long long decrease_interval = 5000;  // 多少次迭代未检测到循环后减小禁忌期
+    unsigned long long plateau_length    = 20000; // 多少次迭代未改进历史最优解视为平台期
+    std::size_t revisit_window           = 0;     // 重访检测记住的最近状态数，0 表示只用冲突数序列（默认，建议 8192）
+    int revisit_threshold                = 200;   // 自上次调整以来累计多少次重访才视为循环
+};
+
+class TabuTenureController {
+public:
+    /**
+     * @brief 控制器的完整状态（检查点保存与恢复用）
+     */
+    struct State {
+        double alpha{0};
+        int random_range{0};
+        unsigned long long last_cycle_iteration{0};      // 上次检测到循环（或减小禁忌期）的迭代
+        unsigned long long last_improvement_iteration{0};// 上次改进历史最优解（或判定平台期）的迭代
+        int pending_revisits{0};                         // 自上次调整以来的重访次数
+        std::vector<int> recent_costs;                   // 最近的冲突数，按时间顺序
+        std::vector<int> match_runs;                     // match_runs[p-1]: 与 p 步前相等的连续次数
+    };
+
+    TabuTenureController() = default;
+
+    /**
+     * @brief 开始新一次搜索：参数回到初值，清空历史
+     */
+    void reset(const TenureConfig &config, double alpha, int random_range);
+
+    /**
+     * @brief 每次迭代（移动施加后）调用一次
+     * @param total_conflict 当前解的冲突数
+     * @param best_improved 本次迭代是否严格改进了历史最优解
+     * @param revisited 当前解是否为最近访问过的状态（见 VisitedSet）
+     */
+    void observe(unsigned long long iteration, int total_conflict, bool best_improved, bool revisited, SearchTelemetry &telemetry);
+
+    [[nodiscard]] double alpha() const { return alpha_; }
+    [[nodiscard]] int random_range() const { return random_range_; }
+
+    [[nodiscard]] State state() const;
+    void restore(const TenureConfig &config, const State &state);
+
+private:
+    TenureConfig config_;
+    double alpha_{0.4};
+    int random_range_{10};
+    unsigned long long last_cycle_iteration_{0};
+    unsigned long long last_improvement_iteration_{0};
+    int pending_revisits_{0};// 自上次调整以来的重访次数
+    std::vector<int> history_;// 环形缓冲区，容量 max_cycle_period + 1
+    int head_{0};             // 下一个写入位置
+    int filled_{0};
+    std::vector<int> match_runs_;
+
+    void adjust_(double alpha_factor, int range_delta, SearchTelemetry &telemetry);
+    void clear_history_();
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_TABU_TENURE_H
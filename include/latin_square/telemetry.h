@@ -0,0 +1,54 @@
+/**
+ * @file telemetry.h
+ * @brief 搜索遥测计数器：记录一次搜索（或恢复后的一段搜索）中各组件的决策次数
+ */
+
+#ifndef LATINSQUARECOMPLETION_TELEMETRY_H
+#define LATINSQUARECOMPLETION_TELEMETRY_H
+
+#include <iosfwd>
+
+namespace qm::latin_square {
+
+struct SearchTelemetry {
+    unsigned long long improvements{0};      // 历史最优解严格改进次数
+    unsigned long long restarts{0};          // 重启次数
+    unsigned long long perturbation_swaps{0};// 扰动施加的交换次数
+    unsigned long long relinks{0};           // 以路径重连的中间解作为起点的重启次数
+    unsigned long long candidate_scans{0};   // 只扫描候选列表邻域的迭代次数
+    unsigned long long candidate_fallbacks{0};// 候选列表中没有改进移动、回退到完整扫描的次数
+
+    // 自适应禁忌期
+    unsigned long long revisits{0};         // 当前解为最近访问过的状态（哈希命中）的次数
+    unsigned long long cycles_detected{0};  // 检测到循环（重访或目标值序列重复）的次数
+    unsigned long long plateaus_detected{0};// 长时间未改进历史最优解的次数
+    unsigned long long tenure_increases{0}; // 增大禁忌期的次数
+    unsigned long long tenure_decreases{0}; // 减小禁忌期的次数
+    double tabu_alpha{0};                   // 当前禁忌期系数
+    int tabu_random_range{0};               // 当前禁忌期随机部分的取值范围
+
+    // 约束加权搜索
+    unsigned long long weight_increases{0}; // 局部最优处增大冲突 (颜色, 列) 权重的次数
+    unsigned long long weight_smoothings{0};// 平滑权重的次数
+
+    // 模拟退火
+    unsigned long long reheats{0};// 重新加热的次数
+
+    // 精确搜索
+    unsigned long long backtracks{0};// 撤销的赋值次数
+
+    // 模因算法
+    unsigned long long offspring{0};         // 产生并改良的子代数
+    unsigned long long offspring_accepted{0};// 被种群接纳的子代数
+
+    void reset() { *this = SearchTelemetry{}; }
+};
+
+/**
+ * @brief 以单行 key=value 形式输出，便于日志检索
+ */
+std::ostream &operator<<(std::ostream &os, const SearchTelemetry &telemetry);
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_TELEMETRY_H
@@ -11,6 +11,7 @@
  * - pos_: 记录每个元素在data_中的位置，用于快速查找
  *
  * 适用于元素ID在固定范围内的场景，支持高效的集合运算。
+ * 底层存储使用 std::pmr 容器，可以从外部内存资源（如搜索工作区）分配。
  */
 
 #ifndef VEC_SET_H
@@ -18,6 +19,7 @@
 
 #include <vector>
 #include <iostream>
+#include <memory_resource>
 #include <stdexcept>
 #include <algorithm>
 
@@ -31,20 +33,34 @@
 class VecSet {
 public:
     // 迭代器类型定义
-    using iterator               = std::vector<int>::iterator;              ///< 正向迭代器
-    using const_iterator         = std::vector<int>::const_iterator;        ///< 常量正向迭代器
-    using reverse_iterator       = std::vector<int>::reverse_iterator;      ///< 反向迭代器
-    using const_reverse_iterator = std::vector<int>::const_reverse_iterator;///< 常量反向迭代器
+    using storage_type           = std::pmr::vector<int>;                   ///< 底层存储类型
+    using iterator               = storage_type::iterator;                  ///< 正向迭代器
+    using const_iterator         = storage_type::const_iterator;            ///< 常量正向迭代器
+    using reverse_iterator       = storage_type::reverse_iterator;          ///< 反向迭代器
+    using const_reverse_iterator = storage_type::const_reverse_iterator;    ///< 常量反向迭代器
+    using allocator_type         = std::pmr::polymorphic_allocator<int>;    ///< 分配器类型（支持 uses-allocator 构造）
 
     /**
      * @brief 构造函数
      * @param universe_size 全集大小，元素ID范围为[0, universe_size)
+     * @param alloc 底层存储使用的分配器
      */
-    explicit VecSet(int universe_size = 0)
-        : pos_(universe_size, -1) {
+    explicit VecSet(int universe_size = 0, const allocator_type &alloc = {})
+        : data_(alloc), pos_(universe_size, -1, alloc) {
         data_.reserve(std::min(universe_size, 64));// 预分配合理容量
     }
 
+    /**
+     * @brief 使用指定分配器构造空集合
+     */
+    explicit VecSet(const allocator_type &alloc) : VecSet(0, alloc) {}
+
+    /**
+     * @brief 使用指定分配器的拷贝/移动构造函数（供 pmr 容器使用）
+     */
+    VecSet(const VecSet &other, const allocator_type &alloc) : data_(other.data_, alloc), pos_(other.pos_, alloc) {}
+    VecSet(VecSet &&other, const allocator_type &alloc) : data_(std::move(other.data_), alloc), pos_(std::move(other.pos_), alloc) {}
+
     /**
      * @brief 移动构造函数
      */
@@ -65,6 +81,32 @@ public:
      */
     VecSet &operator=(const VecSet &) = default;
 
+    /**
+     * @brief 获取底层存储使用的分配器
+     */
+    allocator_type get_allocator() const noexcept { return pos_.get_allocator(); }
+
+    /**
+     * @brief 清空集合并重设全集大小，复用已有容量
+     * @param universe_size 新的全集大小
+     */
+    void reset(int universe_size) {
+        data_.clear();
+        pos_.assign(universe_size, -1);
+        data_.reserve(std::min(universe_size, 64));
+    }
+
+    /**
+     * @brief 将一组集合调整为 count 个全集大小为 universe_size 的空集合，尽量复用已有集合的容量
+     * @param sets 集合数组，新增的集合使用该数组的分配器
+     */
+    static void reset_all(std::pmr::vector<VecSet> &sets, int count, int universe_size) {
+        if (sets.size() > static_cast<size_t>(count)) { sets.erase(sets.begin() + count, sets.end()); }
+        for (auto &set: sets) { set.reset(universe_size); }
+        sets.reserve(count);
+        while (sets.size() < static_cast<size_t>(count)) { sets.emplace_back(universe_size); }
+    }
+
     /**
      * @brief 获取全集大小
      * @return 全集大小
@@ -166,7 +208,7 @@ public:
      * @brief 获取集合中所有元素的只读引用
      * @return 包含所有元素的常量向量引用
      */
-    const std::vector<int> &elements() const noexcept { return data_; }
+    const storage_type &elements() const noexcept { return data_; }
 
     // ==== 迭代器接口 ====
 
@@ -394,8 +436,8 @@ public:
     bool operator!=(const VecSet &other) const noexcept { return !(*this == other); }
 
 private:
-    std::vector<int> data_;///< 存储集合中的实际元素
-    std::vector<int> pos_; ///< 记录每个元素在data_中的位置，-1表示不存在
+    storage_type data_;///< 存储集合中的实际元素
+    storage_type pos_; ///< 记录每个元素在data_中的位置，-1表示不存在
 
     /**
      * @brief 内部方法：已知元素不存在时插入元素
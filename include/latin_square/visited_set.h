@@ -0,0 +1,67 @@
+/**
+ * @file visited_set.h
+ * @brief 最近访问过的解哈希集合：开放寻址（线性探测）哈希表，只记住最近的若干个状态
+ *
+ * 内部维护新、旧两代表：插入写入新一代，新一代写满 window 个元素时整体降为旧一代，
+ * 原旧一代丢弃。查询同时检查两代，因此始终至少记住最近 window 个、至多 2*window 个哈希。
+ * 每代表的槽数为不小于 2*window 的 2 的幂，装载因子不超过 0.5。
+ */
+
+#ifndef LATINSQUARECOMPLETION_VISITED_SET_H
+#define LATINSQUARECOMPLETION_VISITED_SET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace qm::latin_square {
+
+class VisitedSet {
+public:
+    /**
+     * @param window 至少记住的最近状态数，0 表示不记录（visit 始终返回 false）
+     */
+    explicit VisitedSet(std::size_t window = 0) { set_window(window); }
+
+    void set_window(std::size_t window);
+    [[nodiscard]] std::size_t window() const { return window_; }
+
+    /**
+     * @brief 记录一个状态
+     * @return 该状态是否在最近的窗口内出现过
+     */
+    bool visit(std::uint64_t hash);
+
+    [[nodiscard]] bool contains(std::uint64_t hash) const;
+
+    void clear();
+
+    /**
+     * @brief 按代导出（检查点用）：先旧一代、后新一代；按此顺序重新 visit 可恢复相同的成员与分代
+     */
+    void export_generations(std::vector<std::uint64_t> &older, std::vector<std::uint64_t> &newer) const;
+    void restore_generations(const std::vector<std::uint64_t> &older, const std::vector<std::uint64_t> &newer);
+
+private:
+    struct Table {
+        std::vector<std::uint64_t> slots;// 0 表示空槽
+        std::size_t size{0};
+
+        [[nodiscard]] bool contains(std::uint64_t key, std::size_t mask) const;
+        void insert(std::uint64_t key, std::size_t mask);
+        void clear();
+    };
+
+    std::size_t window_{0};
+    std::size_t mask_{0};
+    Table newer_;
+    Table older_;
+
+    // 0 保留为空槽标记
+    static std::uint64_t key_of(std::uint64_t hash) { return hash == 0 ? 1 : hash; }
+    void insert_(std::uint64_t key);
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_VISITED_SET_H
@@ -0,0 +1,96 @@
+/**
+ * @file weighting_search.h
+ * @brief 约束加权 + 配置检测（configuration checking）局部搜索引擎
+ *
+ * 邻域与禁忌搜索相同（行内交换冲突节点与冲突/非冲突节点），评估函数改为加权冲突数：
+ * 每个 (颜色, 列) 对带一个权重 w，目标为 sum w * (该列该颜色的格子对数)。
+ * - 配置检测代替禁忌表：格子被移动后，只有当它所在列中有格子再次变化（其“配置”改变）时
+ *   才允许再次移动它；一次交换中的两格只要有一格允许移动即可，能改进历史最优解的移动不受此限制；
+ * - 不存在允许的加权下降移动时处于加权意义下的局部最优：所有冲突 (颜色, 列) 对的权重加一，
+ *   以 smoothing_probability 的概率改为把所有大于 1 的权重减一（平滑），然后执行允许的加权最优移动；
+ *   所有移动都不被允许时，从随机冲突节点出发做一次加权最优的交换（平局选最久未移动的格子）。
+ */
+
+#ifndef LATINSQUARECOMPLETION_WEIGHTING_SEARCH_H
+#define LATINSQUARECOMPLETION_WEIGHTING_SEARCH_H
+
+#include "latin_square/engine.h"
+#include "latin_square/evaluator.h"
+#include "latin_square/latin_square.h"
+#include "latin_square/move.h"
+#include "latin_square/row_conflict_grid.h"
+#include "latin_square/search_workspace.h"
+#include "latin_square/telemetry.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+
+namespace qm::latin_square {
+
+/**
+ * @brief 约束加权搜索参数
+ */
+struct WeightingConfig {
+    double smoothing_probability = 0.01;// 局部最优处改为平滑权重的概率
+    bool verbose                 = true;// 是否向 std::clog 输出搜索进度
+};
+
+class WeightingSearch : public SearchEngine {
+public:
+    explicit WeightingSearch(const WeightingConfig &config = {})
+        : config_(config), evaluator_(workspace_.resource()), row_grid_(workspace_.resource()), weight_(workspace_.resource()),
+          conf_changed_(workspace_.resource()), last_moved_(workspace_.resource()) {}
+
+    WeightingSearch(const WeightingSearch &)            = delete;
+    WeightingSearch &operator=(const WeightingSearch &) = delete;
+
+    [[nodiscard]] std::string_view name() const override { return "weighting"; }
+
+    void search(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration = 0, double time_limit_seconds = 0) override;
+
+    void set_config(const WeightingConfig &config) { config_ = config; }
+    [[nodiscard]] const WeightingConfig &config() const { return config_; }
+
+    void set_improvement_callback(ImprovementCallback callback) override { on_improvement_ = std::move(callback); }
+    void set_stop_flag(const std::atomic<bool> *stop_flag) override { stop_flag_ = stop_flag; }
+
+    [[nodiscard]] const Solution &best_solution() const override { return best_solution_; }
+    [[nodiscard]] unsigned long long iteration() const override { return iteration_; }
+    [[nodiscard]] const SearchTelemetry &telemetry() const override { return telemetry_; }
+
+private:
+    // 工作区必须先于从中分配内存的成员构造、后于它们析构
+    SearchWorkspace workspace_;
+    WeightingConfig config_;
+    ImprovementCallback on_improvement_;
+    const std::atomic<bool> *stop_flag_{nullptr};
+    SearchTelemetry telemetry_;
+    unsigned long long iteration_{};
+    const LatinSquare *latin_square_{nullptr};// 只在搜索期间引用调用方的拉丁方，search 返回时置空
+    Solution current_solution_;
+    Solution best_solution_;
+    Evaluator evaluator_;
+    RowConflictGrid row_grid_;
+    std::pmr::vector<long long> weight_;             // weight_[color * N + col]: (颜色, 列) 对的权重
+    std::pmr::vector<std::uint8_t> conf_changed_;    // conf_changed_[row * N + col]: 上次移动后配置是否改变
+    std::pmr::vector<unsigned long long> last_moved_;// last_moved_[row * N + col]: 上次移动该格的迭代次数
+    int N_{};
+
+    // search 的主体，返回后由 search 解除对拉丁方的引用
+    void run_(const LatinSquare &latin_square, const Solution &solution, unsigned long long max_iteration, double time_limit_seconds);
+    void prepare_workspace_(int N);
+    bool update_best_();
+    // 加权冲突数的变化量
+    [[nodiscard]] long long weighted_delta_(const Move &move) const;
+    // 配置检测允许（或满足特赦条件）的加权最优移动，descending_only 为真时只考虑加权下降的移动；不存在时 row_id 为 -1
+    [[nodiscard]] Move find_move_(bool descending_only) const;
+    // 从随机冲突节点出发的加权最优交换
+    [[nodiscard]] Move random_walk_move_() const;
+    void update_weights_();
+    void make_move_(const Move &move);
+};
+
+}// namespace qm::latin_square
+
+#endif// LATINSQUARECOMPLETION_WEIGHTING_SEARCH_H
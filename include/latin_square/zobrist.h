@@ -0,0 +1,54 @@
+/**
+ * @file zobrist.h
+ * @brief 方阵的 Zobrist 哈希：每个 (行, 列, 颜色) 对应一个 64 位键，整张方阵的哈希为所有格子键的异或
+ *
+ * 键由 splitmix64 按坐标即时计算，不需要 n^3 大小的随机表；交换同一行的两个格子时，
+ * 哈希可以用四个键的异或在 O(1) 内更新。
+ */
+
+#ifndef LATINSQUARECOMPLETION_ZOBRIST_H
+#define LATINSQUARECOMPLETION_ZOBRIST_H
+
+#include <cstdint>
+#include <vector>
+
+namespace qm::latin_square::zobrist {
+
+/**
+ * @brief splitmix64 混合函数
+ */
+[[nodiscard]] constexpr std::uint64_t mix(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief 第 row 行第 col 列填颜色 color 的键
+ */
+[[nodiscard]] constexpr std::uint64_t key(int row, int col, int color) {
+    return mix((static_cast<std::uint64_t>(row) << 42) ^ (static_cast<std::uint64_t>(col) << 21) ^ static_cast<std::uint64_t>(color));
+}
+
+/**
+ * @brief 交换第 row 行 col1、col2 两格（颜色分别为 color1、color2）时哈希的增量，与原哈希异或即可
+ */
+[[nodiscard]] constexpr std::uint64_t swap_delta(int row, int col1, int col2, int color1, int color2) {
+    return key(row, col1, color1) ^ key(row, col1, color2) ^ key(row, col2, color2) ^ key(row, col2, color1);
+}
+
+/**
+ * @brief 从头计算整张方阵的哈希
+ */
+[[nodiscard]] inline std::uint64_t hash(const std::vector<std::vector<int>> &grid) {
+    std::uint64_t h = 0;
+    for (int row = 0; row < static_cast<int>(grid.size()); ++row) {
+        for (int col = 0; col < static_cast<int>(grid[row].size()); ++col) { h ^= key(row, col, grid[row][col]); }
+    }
+    return h;
+}
+
+}// namespace qm::latin_square::zobrist
+
+#endif// LATINSQUARECOMPLETION_ZOBRIST_H
@@ -6,14 +6,80 @@
 #define RANDOM_GENERATOR_H
 
 #include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <initializer_list>
+#include <istream>
+#include <limits>
+#include <ostream>
 #include <random>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace qm {
+    /**
+     * @brief xoshiro256++ 随机引擎（满足 UniformRandomBitGenerator），状态 256 位，单次生成只需几次移位与加法
+     * @details 种子经 splitmix64 展开为四个状态字；状态以四个十进制整数的文本形式读写
+     */
+    class Xoshiro256pp {
+    public:
+        using result_type = std::uint64_t;
+
+        explicit Xoshiro256pp(const std::uint64_t seed = 0) { this->seed(seed); }
+
+        static constexpr result_type min() { return 0; }
+
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        void seed(std::uint64_t seed) {
+            for (auto &word: s_) {
+                seed += 0x9E3779B97F4A7C15ULL;
+                std::uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        result_type operator()() {
+            const std::uint64_t result = rotl(s_[0] + s_[3], 23) + s_[0];
+            const std::uint64_t t      = s_[1] << 17;
+            s_[2] ^= s_[0];
+            s_[3] ^= s_[1];
+            s_[1] ^= s_[2];
+            s_[0] ^= s_[3];
+            s_[2] ^= t;
+            s_[3] = rotl(s_[3], 45);
+            return result;
+        }
+
+        friend std::ostream &operator<<(std::ostream &os, const Xoshiro256pp &engine) {
+            return os << engine.s_[0] << ' ' << engine.s_[1] << ' ' << engine.s_[2] << ' ' << engine.s_[3];
+        }
+
+        friend std::istream &operator>>(std::istream &is, Xoshiro256pp &engine) {
+            std::uint64_t s[4];
+            if (is >> s[0] >> s[1] >> s[2] >> s[3]) { std::copy(s, s + 4, engine.s_); }
+            return is;
+        }
+
+    private:
+        std::uint64_t s_[4]{};
+
+        static std::uint64_t rotl(const std::uint64_t x, const int k) { return (x << k) | (x >> (64 - k)); }
+    };
+
     class RandomGenerator {
     public:
+        // QM_FAST_RNG 时使用 xoshiro256++ 与 Lemire 有界采样，否则使用 mt19937 与标准分布（两者的随机序列不同）
+#ifdef QM_FAST_RNG
+        using Engine = Xoshiro256pp;
+#else
+        using Engine = std::mt19937;
+#endif
+
         static RandomGenerator &instance() {
             thread_local RandomGenerator instance;
             return instance;
@@ -31,15 +97,41 @@ namespace qm {
             gen.seed(seed);
         }
 
+        /**
+         * @brief 导出随机引擎的完整状态（文本形式），用于检查点
+         */
+        [[nodiscard]] std::string saveState() const {
+            std::ostringstream os;
+            os << gen;
+            return os.str();
+        }
+
+        /**
+         * @brief 恢复由 saveState() 导出的随机引擎状态
+         */
+        void restoreState(const std::string &state) {
+            std::istringstream is(state);
+            Engine restored;
+            if (!(is >> restored)) {
+                throw std::invalid_argument("invalid random generator state");
+            }
+            gen = restored;
+        }
+
         /**
          * @brief 生成[min, max]范围内的随机整数
          */
         int getInt(int min, int max) {
+#ifdef QM_FAST_RNG
+            assert(min <= max);
+            return min + static_cast<int>(bounded(static_cast<std::uint32_t>(max - min) + 1));
+#else
             if (min > max) {
                 throw std::invalid_argument("min must be less than or equal to max");
             }
             std::uniform_int_distribution<int> dist(min, max);
             return dist(gen);
+#endif
         }
 
         /**
@@ -56,10 +148,17 @@ namespace qm {
             if (min > max) {
                 throw std::invalid_argument("min must be less than or equal to max");
             }
+#ifdef QM_FAST_RNG
+            const auto range = static_cast<std::uint32_t>(max - min) + 1;
+            for (size_t i = 0; i < count; ++i) {
+                output[i] = min + static_cast<int>(bounded(range));
+            }
+#else
             std::uniform_int_distribution<int> dist(min, max);
             for (size_t i = 0; i < count; ++i) {
                 output[i] = dist(gen);
             }
+#endif
         }
 
         /**
@@ -124,14 +223,33 @@ namespace qm {
          * @brief 直接访问随机引擎
          */
         template<typename F>
-        auto withEngine(F &&f) -> decltype(f(std::declval<std::mt19937 &>())) {
+        auto withEngine(F &&f) -> decltype(f(std::declval<Engine &>())) {
             return f(gen);
         }
 
     private:
         RandomGenerator() : gen(std::random_device{}()) {}
 
-        std::mt19937 gen;
+        Engine gen;
+
+#ifdef QM_FAST_RNG
+        /**
+         * @brief Lemire 的近似无除法有界采样：返回 [0, range) 内的均匀整数，range 必须大于 0
+         * @details 取 64 位输出的高 32 位乘以 range，只有落入拒绝区间的低位才需要一次取模
+         */
+        std::uint32_t bounded(const std::uint32_t range) {
+            std::uint64_t product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(gen() >> 32)) * range;
+            auto low              = static_cast<std::uint32_t>(product);
+            if (low < range) {
+                const std::uint32_t threshold = (0u - range) % range;
+                while (low < threshold) {
+                    product = static_cast<std::uint64_t>(static_cast<std::uint32_t>(gen() >> 32)) * range;
+                    low     = static_cast<std::uint32_t>(product);
+                }
+            }
+            return static_cast<std::uint32_t>(product >> 32);
+        }
+#endif
     };
 
 // 便捷函数
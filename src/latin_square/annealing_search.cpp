@@ -0,0 +1,180 @@
+#include "latin_square/annealing_search.h"
+
+#include "latin_square/zobrist.h"
+#include "utils/RandomGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+namespace qm::latin_square {
+
+namespace {
+constexpr unsigned long long CHECK_INTERVAL = 1024;// 每隔多少次采样检查一次时间限制与停止标志
+}// namespace
+
+void AnnealingSearch::search(const LatinSquare &latin_square, const Solution &solution, const unsigned long long max_iteration, const double time_limit_seconds) {
+    run_(latin_square, solution, max_iteration, time_limit_seconds);
+    // 搜索返回后不再引用调用方的拉丁方
+    latin_square_ = nullptr;
+    evaluator_.detach();
+}
+
+void AnnealingSearch::run_(const LatinSquare &latin_square, const Solution &solution, const unsigned long long max_iteration, const double time_limit_seconds) {
+    const int N = latin_square.get_instance_size();
+    prepare_workspace_(N);
+    latin_square_     = &latin_square;
+    current_solution_ = solution;
+    best_solution_    = solution;
+    iteration_        = 0;
+    telemetry_.reset();
+    evaluator_.reset(latin_square, solution);
+    row_grid_.rebuild(latin_square, evaluator_, current_solution_);
+    conflict_rows_.reset(N);
+    free_rows_.clear();
+    int free_cells = 0;
+    for (auto row = 0; row < N; ++row) {
+        if (!row_grid_.conflict(row).empty()) { conflict_rows_.insert(row); }
+        if (row_grid_.free_count(row) >= 2) { free_rows_.push_back(row); }
+        free_cells += row_grid_.free_count(row);
+    }
+    if (free_rows_.empty()) { throw std::runtime_error("No valid move found in AnnealingSearch"); }
+    const auto epoch_length = config_.epoch_length > 0 ? config_.epoch_length : static_cast<unsigned long long>(std::max(free_cells, 1));
+    temperature_            = config_.initial_temperature;
+
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    const auto elapsed    = [&start_time] { return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count(); };
+
+    while (iteration_ < max_iteration) {
+        if (iteration_ % CHECK_INTERVAL == 0) {
+            if (stop_flag_ != nullptr && stop_flag_->load(std::memory_order_relaxed)) {
+                if (config_.verbose) { std::clog << "收到停止请求，搜索终止，最终冲突数: " << best_solution_.total_conflict << std::endl; }
+                return;
+            }
+            if (time_limit_seconds > 0 && elapsed() >= time_limit_seconds) {
+                if (config_.verbose) {
+                    std::clog << "达到时间限制 " << time_limit_seconds << " 秒，搜索终止" << std::endl;
+                    std::clog << "最终冲突数: " << best_solution_.total_conflict << std::endl;
+                    std::clog << "遥测: " << telemetry_ << std::endl;
+                }
+                return;
+            }
+        }
+
+        const auto move  = sample_move_();
+        const auto delta = evaluator_.evaluate_conflict_delta(current_solution_, move);
+        // Metropolis 准则：冲突数不增加的交换总是接受
+        if (delta <= 0 || randomDouble(0.0, 1.0) < std::exp(-delta / temperature_)) {
+            make_move_(move);
+            if (delta < 0) { update_best_(); }
+            if (current_solution_.total_conflict == 0) {
+                if (config_.verbose) {
+                    std::clog << "Iteration: " << iteration_ << " conflict = 0, return." << std::endl;
+                    std::clog << "求解时间: " << std::fixed << std::setprecision(3) << elapsed() << " s" << std::endl;
+                    std::clog << "遥测: " << telemetry_ << std::endl;
+                }
+                return;
+            }
+        }
+
+        ++iteration_;
+        if (iteration_ % epoch_length == 0) {
+            temperature_ *= config_.cooling_rate;
+            if (temperature_ < config_.final_temperature) { reheat_(); }
+        }
+    }
+
+    if (config_.verbose) {
+        std::clog << "搜索结束，总时间: " << std::fixed << std::setprecision(3) << elapsed() << " s" << std::endl;
+        std::clog << "最终冲突数: " << best_solution_.total_conflict << std::endl;
+        std::clog << "遥测: " << telemetry_ << std::endl;
+    }
+}
+
+void AnnealingSearch::prepare_workspace_(const int N) {
+    if (!workspace_.needs_growth(N)) { return; }
+    // 出现了更大的规模：先归还所有从工作区分配的结构，再整体重置并扩容
+    evaluator_.release();
+    row_grid_.release();
+    conflict_rows_ = VecSet(conflict_rows_.get_allocator());
+    workspace_.grow(N);
+}
+
+void AnnealingSearch::update_best_() {
+    // 只在严格改进时复制，接受的平移交换很多，逐次复制整张方阵代价过高
+    if (!(current_solution_ < best_solution_)) { return; }
+    const bool improved = current_solution_.total_conflict < best_solution_.total_conflict;
+    best_solution_      = current_solution_;
+    if (improved) {
+        ++telemetry_.improvements;
+        if (on_improvement_) { on_improvement_(best_solution_, iteration_); }
+    }
+}
+
+Move AnnealingSearch::sample_move_() const {
+    bool directed = !conflict_rows_.empty() && randomDouble(0.0, 1.0) < config_.conflict_directed;
+    // 行内非固定格按 [冲突节点..., 非冲突节点...] 统一编号
+    const auto free_col = [this](const int row, const int index) {
+        const auto conflicts = row_grid_.conflict(row).size();
+        return index < conflicts ? row_grid_.conflict(row)[index] : row_grid_.nonconflict(row)[index - conflicts];
+    };
+
+    int row = directed ? conflict_rows_[randomInt(conflict_rows_.size())] : -1;
+    // 冲突行只有一个非固定格时无法交换，退回随机采样
+    if (row < 0 || row_grid_.free_count(row) < 2) {
+        directed = false;
+        row      = free_rows_[randomInt(static_cast<int>(free_rows_.size()))];
+    }
+    const int count  = row_grid_.free_count(row);
+    const int col1   = directed ? row_grid_.conflict(row)[randomInt(row_grid_.conflict(row).size())] : free_col(row, randomInt(count));
+    const int color1 = current_solution_.get_color(row, col1);
+
+    Move candidate{row, col1, -1};
+    for (auto attempt = 0; attempt < std::max(1, config_.domain_attempts); ++attempt) {
+        int col2 = free_col(row, randomInt(count - 1));
+        if (col2 == col1) { col2 = free_col(row, count - 1); }// 跳过 col1：把它换成编号最大的格子
+        candidate.col2 = col2;
+        // 交换后两格颜色都在颜色域内则直接采用，否则继续尝试，最终退回最后一个候选
+        if (latin_square_->color_in_domain(row, col1, current_solution_.get_color(row, col2)) && latin_square_->color_in_domain(row, col2, color1)) { break; }
+    }
+    return candidate;
+}
+
+void AnnealingSearch::make_move_(const Move &move) {
+    const auto move_delta1    = evaluator_.evaluate_conflict_delta(current_solution_, move);
+    const auto move_delta2    = evaluator_.evaluate_domain_delta(current_solution_, move);
+    const auto affected_cells = evaluator_.update(current_solution_, move);
+    current_solution_.total_conflict += move_delta1;
+    current_solution_.domain_conflict += move_delta2;
+    current_solution_.hash ^= zobrist::swap_delta(move.row_id, move.col1, move.col2, current_solution_.get_color(move.row_id, move.col1),
+                                                  current_solution_.get_color(move.row_id, move.col2));
+    std::swap(current_solution_.solution[move.row_id][move.col1], current_solution_.solution[move.row_id][move.col2]);
+    row_grid_.update(*latin_square_, evaluator_, current_solution_, affected_cells);
+
+    // 交换只改变两列中格子的冲突状态，逐行刷新冲突行集合
+    for (auto row = 0; row < static_cast<int>(current_solution_.solution.size()); ++row) {
+        if (row_grid_.conflict(row).empty()) {
+            conflict_rows_.erase(row);
+        } else {
+            conflict_rows_.insert(row);
+        }
+    }
+}
+
+void AnnealingSearch::reheat_() {
+    ++telemetry_.reheats;
+    temperature_ = config_.initial_temperature;
+    if (!config_.reheat_from_best || current_solution_.total_conflict == best_solution_.total_conflict) { return; }
+    current_solution_ = best_solution_;
+    evaluator_.reset(*latin_square_, current_solution_);
+    row_grid_.rebuild(*latin_square_, evaluator_, current_solution_);
+    conflict_rows_.reset(static_cast<int>(current_solution_.solution.size()));
+    for (auto row = 0; row < static_cast<int>(current_solution_.solution.size()); ++row) {
+        if (!row_grid_.conflict(row).empty()) { conflict_rows_.insert(row); }
+    }
+}
+
+}// namespace qm::latin_square
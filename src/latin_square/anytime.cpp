@@ -0,0 +1,92 @@
+#include "latin_square/anytime.h"
+
+#include "latin_square/binary_io.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace qm::latin_square {
+
+AnytimeWriter::AnytimeWriter(std::string path, const double min_interval_seconds, const bool binary)
+    : path_(std::move(path)),
+      min_interval_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(std::max(0.0, min_interval_seconds)))),
+      binary_(binary),
+      timer_([this] { run_timer_(); }) {}
+
+AnytimeWriter::~AnytimeWriter() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    timer_.join();
+}
+
+void AnytimeWriter::offer(const Solution &best) {
+    std::lock_guard lock(mutex_);
+    const auto now = std::chrono::steady_clock::now();
+    if (has_written_ && now - last_write_ < min_interval_) {
+        // 限速期内只保留最新的解，复用暂存解的容量
+        pending_ = best;
+        if (!has_pending_) {
+            has_pending_ = true;
+            wake_.notify_one();
+        }
+        return;
+    }
+    write_(best);
+}
+
+void AnytimeWriter::flush() {
+    std::lock_guard lock(mutex_);
+    if (!has_pending_) { return; }
+    write_(pending_);
+}
+
+unsigned long long AnytimeWriter::writes() const {
+    std::lock_guard lock(mutex_);
+    return writes_;
+}
+
+void AnytimeWriter::run_timer_() {
+    std::unique_lock lock(mutex_);
+    while (!stopping_) {
+        if (!has_pending_) {
+            wake_.wait(lock, [this] { return stopping_ || has_pending_; });
+            continue;
+        }
+        const auto due = last_write_ + min_interval_;
+        if (wake_.wait_until(lock, due, [this] { return stopping_ || !has_pending_; })) { continue; }
+        try {
+            write_(pending_);
+        } catch (const std::exception &) {
+            // 写入失败时保留暂存的解，隔一个间隔后重试；flush() 仍会向调用方报告错误
+            last_write_ = std::chrono::steady_clock::now();
+        }
+    }
+}
+
+void AnytimeWriter::write_(const Solution &solution) {
+    const auto temp_path = path_ + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out) { throw std::runtime_error("Cannot open " + temp_path); }
+        if (binary_) {
+            binary::write_solution(out, solution);
+        } else {
+            writer_.write(out, solution);
+        }
+        if (!out.flush()) { throw std::runtime_error("Failed to write " + temp_path); }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path_, ec);
+    if (ec) { throw std::runtime_error("Failed to move " + temp_path + " into place: " + ec.message()); }
+    has_pending_ = false;
+    has_written_ = true;
+    last_write_  = std::chrono::steady_clock::now();
+    ++writes_;
+}
+
+}// namespace qm::latin_square
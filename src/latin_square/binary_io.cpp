@@ -0,0 +1,374 @@
+#include "latin_square/binary_io.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define QM_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace qm::latin_square::binary {
+
+namespace {
+
+constexpr char INSTANCE_MAGIC[4] = {'L', 'S', 'Q', 'I'};
+constexpr char SOLUTION_MAGIC[4] = {'L', 'S', 'Q', 'S'};
+constexpr char BUNDLE_MAGIC[4]   = {'L', 'S', 'Q', 'B'};
+constexpr int MAX_ORDER          = 0xFFFF;
+
+std::size_t align_up(std::size_t size) { return (size + RECORD_ALIGNMENT - 1) / RECORD_ALIGNMENT * RECORD_ALIGNMENT; }
+
+void put_u16(std::uint8_t *p, std::uint16_t v) {
+    p[0] = static_cast<std::uint8_t>(v);
+    p[1] = static_cast<std::uint8_t>(v >> 8);
+}
+
+void put_u32(std::uint8_t *p, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) { p[i] = static_cast<std::uint8_t>(v >> (8 * i)); }
+}
+
+void put_u64(std::uint8_t *p, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) { p[i] = static_cast<std::uint8_t>(v >> (8 * i)); }
+}
+
+std::uint16_t get_u16(const std::uint8_t *p) { return static_cast<std::uint16_t>(p[0] | (p[1] << 8)); }
+
+std::uint32_t get_u32(const std::uint8_t *p) {
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) { v |= static_cast<std::uint32_t>(p[i]) << (8 * i); }
+    return v;
+}
+
+std::uint64_t get_u64(const std::uint8_t *p) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) { v |= static_cast<std::uint64_t>(p[i]) << (8 * i); }
+    return v;
+}
+
+bool has_magic(ByteSpan data, const char (&magic)[4]) { return data.size() >= 4 && std::memcmp(data.data(), magic, 4) == 0; }
+
+// 按 LSB 优先顺序写入定宽整数，目标区域需预先清零
+class BitWriter {
+public:
+    explicit BitWriter(std::uint8_t *dst) : dst_(dst) {}
+
+    void put(std::uint32_t value, int width) {
+        for (int b = 0; b < width; ++b, ++pos_) {
+            if ((value >> b) & 1U) { dst_[pos_ >> 3] |= static_cast<std::uint8_t>(1U << (pos_ & 7)); }
+        }
+    }
+
+private:
+    std::uint8_t *dst_;
+    std::size_t pos_{0};
+};
+
+class BitReader {
+public:
+    explicit BitReader(const std::uint8_t *src) : src_(src) {}
+
+    std::uint32_t get(int width) {
+        std::uint32_t value = 0;
+        for (int b = 0; b < width; ++b, ++pos_) {
+            if ((src_[pos_ >> 3] >> (pos_ & 7)) & 1U) { value |= 1U << b; }
+        }
+        return value;
+    }
+
+private:
+    const std::uint8_t *src_;
+    std::size_t pos_{0};
+};
+
+std::size_t bitmap_bytes(int n) { return align_up((static_cast<std::size_t>(n) * n + 7) / 8); }
+
+std::size_t packed_bytes(std::size_t count, int width) { return align_up((count * width + 7) / 8); }
+
+void check_order(int n) {
+    if (n <= 0 || n > MAX_ORDER) { throw std::invalid_argument("Latin square order out of range: " + std::to_string(n)); }
+}
+
+// 解析通用 16 字节头部：magic(4) version(2) n(2) ... value_bits(1)
+int parse_header(ByteSpan data, const char (&magic)[4], const char *what) {
+    if (data.size() < RECORD_HEADER_SIZE) { throw std::runtime_error(std::string("Truncated ") + what + " header"); }
+    if (!has_magic(data, magic)) { throw std::runtime_error(std::string("Bad ") + what + " magic"); }
+    if (const auto version = get_u16(data.data() + 4); version == 0 || version > FORMAT_VERSION) {
+        throw std::runtime_error(std::string("Unsupported ") + what + " format version " + std::to_string(version));
+    }
+    const int n = get_u16(data.data() + 6);
+    if (n == 0) { throw std::runtime_error(std::string("Invalid ") + what + " order 0"); }
+    if (data[12] != value_bit_width(n)) { throw std::runtime_error(std::string("Invalid ") + what + " value width"); }
+    return n;
+}
+
+template<typename Decode>
+auto read_record(std::istream &is, const char (&magic)[4], const char *what, std::size_t (*record_size)(const std::uint8_t *), Decode decode) {
+    Bytes buffer(RECORD_HEADER_SIZE);
+    if (!is.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()))) {
+        throw std::runtime_error(std::string("Failed to read ") + what + " header");
+    }
+    parse_header(buffer, magic, what);
+    buffer.resize(record_size(buffer.data()));
+    const auto rest = static_cast<std::streamsize>(buffer.size() - RECORD_HEADER_SIZE);
+    if (!is.read(reinterpret_cast<char *>(buffer.data() + RECORD_HEADER_SIZE), rest)) {
+        throw std::runtime_error(std::string("Truncated ") + what + " record");
+    }
+    return decode(ByteSpan{buffer});
+}
+
+}// namespace
+
+int value_bit_width(int n) { return std::max(1, static_cast<int>(std::bit_width(static_cast<unsigned>(n > 0 ? n - 1 : 0)))); }
+
+bool is_instance_record(ByteSpan data) { return has_magic(data, INSTANCE_MAGIC); }
+bool is_solution_record(ByteSpan data) { return has_magic(data, SOLUTION_MAGIC); }
+bool is_bundle(ByteSpan data) { return has_magic(data, BUNDLE_MAGIC); }
+
+// ==== 实例 ====
+
+std::size_t instance_record_size(int n, std::size_t fixed_count) {
+    return RECORD_HEADER_SIZE + bitmap_bytes(n) + packed_bytes(fixed_count, value_bit_width(n));
+}
+
+void encode_instance(const Instance &instance, Bytes &out) {
+    const int n = instance.size();
+    check_order(n);
+    // 先落到网格上，去重并得到行优先顺序
+    std::vector<int> grid(static_cast<std::size_t>(n) * n, -1);
+    std::size_t fixed_count = 0;
+    for (const auto &a: instance.fixed()) {
+        if (a.row < 0 || a.row >= n || a.col < 0 || a.col >= n || a.num < 0 || a.num >= n) {
+            throw std::invalid_argument("Assignment out of range in instance");
+        }
+        auto &cell = grid[static_cast<std::size_t>(a.row) * n + a.col];
+        if (cell == -1) { ++fixed_count; }
+        cell = a.num;
+    }
+
+    const int width   = value_bit_width(n);
+    const auto base   = out.size();
+    const auto length = instance_record_size(n, fixed_count);
+    out.resize(base + length, 0);
+    auto *p = out.data() + base;
+    std::memcpy(p, INSTANCE_MAGIC, 4);
+    put_u16(p + 4, FORMAT_VERSION);
+    put_u16(p + 6, static_cast<std::uint16_t>(n));
+    put_u32(p + 8, static_cast<std::uint32_t>(fixed_count));
+    p[12] = static_cast<std::uint8_t>(width);
+
+    auto *bitmap = p + RECORD_HEADER_SIZE;
+    BitWriter values(bitmap + bitmap_bytes(n));
+    for (std::size_t idx = 0; idx < grid.size(); ++idx) {
+        if (grid[idx] == -1) { continue; }
+        bitmap[idx >> 3] |= static_cast<std::uint8_t>(1U << (idx & 7));
+        values.put(static_cast<std::uint32_t>(grid[idx]), width);
+    }
+}
+
+Instance decode_instance(ByteSpan data, std::size_t *consumed) {
+    const int n            = parse_header(data, INSTANCE_MAGIC, "instance");
+    const auto fixed_count = get_u32(data.data() + 8);
+    if (fixed_count > static_cast<std::uint64_t>(n) * n) { throw std::runtime_error("Invalid instance fixed count"); }
+    const auto length = instance_record_size(n, fixed_count);
+    if (data.size() < length) { throw std::runtime_error("Truncated instance record"); }
+
+    const int width    = value_bit_width(n);
+    const auto *bitmap = data.data() + RECORD_HEADER_SIZE;
+    BitReader values(bitmap + bitmap_bytes(n));
+    std::vector<Assignment> fixed;
+    fixed.reserve(fixed_count);
+    const auto cells = static_cast<std::size_t>(n) * n;
+    for (std::size_t idx = 0; idx < cells; ++idx) {
+        if (((bitmap[idx >> 3] >> (idx & 7)) & 1U) == 0) { continue; }
+        if (fixed.size() == fixed_count) { throw std::runtime_error("Instance bitmap does not match fixed count"); }
+        const auto value = static_cast<int>(values.get(width));
+        if (value >= n) { throw std::runtime_error("Instance value out of range"); }
+        fixed.emplace_back(static_cast<int>(idx / n), static_cast<int>(idx % n), value);
+    }
+    if (fixed.size() != fixed_count) { throw std::runtime_error("Instance bitmap does not match fixed count"); }
+    if (consumed != nullptr) { *consumed = length; }
+    return Instance{n, std::move(fixed)};
+}
+
+void write_instance(std::ostream &os, const Instance &instance) {
+    Bytes buffer;
+    encode_instance(instance, buffer);
+    os.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+}
+
+Instance read_instance(std::istream &is) {
+    return read_record(
+            is, INSTANCE_MAGIC, "instance",
+            [](const std::uint8_t *header) { return instance_record_size(get_u16(header + 6), get_u32(header + 8)); },
+            [](ByteSpan data) { return decode_instance(data); });
+}
+
+// ==== 解 ====
+
+std::size_t solution_record_size(int n) {
+    return RECORD_HEADER_SIZE + packed_bytes(static_cast<std::size_t>(n) * n, value_bit_width(n));
+}
+
+void encode_solution(const Solution &solution, Bytes &out) {
+    const int n = static_cast<int>(solution.solution.size());
+    check_order(n);
+    const int width = value_bit_width(n);
+    const auto base = out.size();
+    out.resize(base + solution_record_size(n), 0);
+    auto *p = out.data() + base;
+    std::memcpy(p, SOLUTION_MAGIC, 4);
+    put_u16(p + 4, FORMAT_VERSION);
+    put_u16(p + 6, static_cast<std::uint16_t>(n));
+    put_u32(p + 8, static_cast<std::uint32_t>(solution.total_conflict));
+    p[12] = static_cast<std::uint8_t>(width);
+
+    BitWriter cells(p + RECORD_HEADER_SIZE);
+    for (const auto &row: solution.solution) {
+        if (static_cast<int>(row.size()) != n) { throw std::invalid_argument("Solution is not square"); }
+        for (const auto val: row) { cells.put(static_cast<std::uint32_t>(val), width); }
+    }
+}
+
+Solution decode_solution(ByteSpan data, std::size_t *consumed) {
+    const int n       = parse_header(data, SOLUTION_MAGIC, "solution");
+    const auto length = solution_record_size(n);
+    if (data.size() < length) { throw std::runtime_error("Truncated solution record"); }
+
+    const int width = value_bit_width(n);
+    BitReader cells(data.data() + RECORD_HEADER_SIZE);
+    std::vector<std::vector<int>> grid(n, std::vector<int>(n));
+    for (auto &row: grid) {
+        for (auto &val: row) {
+            val = static_cast<int>(cells.get(width));
+            if (val >= n) { throw std::runtime_error("Solution value out of range"); }
+        }
+    }
+    if (consumed != nullptr) { *consumed = length; }
+    // 冲突数据由网格重新计算，头部中的冲突数仅供查看
+    return Solution{std::move(grid)};
+}
+
+void write_solution(std::ostream &os, const Solution &solution) {
+    Bytes buffer;
+    encode_solution(solution, buffer);
+    os.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+}
+
+Solution read_solution(std::istream &is) {
+    return read_record(
+            is, SOLUTION_MAGIC, "solution",
+            [](const std::uint8_t *header) { return solution_record_size(get_u16(header + 6)); },
+            [](ByteSpan data) { return decode_solution(data); });
+}
+
+// ==== 实例包 ====
+
+void write_bundle(std::ostream &os, std::span<const Instance> instances) {
+    const auto count = instances.size();
+    Bytes buffer(RECORD_HEADER_SIZE + align_up(count * sizeof(std::uint64_t)), 0);
+    std::memcpy(buffer.data(), BUNDLE_MAGIC, 4);
+    put_u16(buffer.data() + 4, FORMAT_VERSION);
+    put_u64(buffer.data() + 8, count);
+    for (std::size_t i = 0; i < count; ++i) {
+        put_u64(buffer.data() + RECORD_HEADER_SIZE + i * sizeof(std::uint64_t), buffer.size());
+        encode_instance(instances[i], buffer);
+    }
+    os.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+}
+
+BundleView::BundleView(ByteSpan data) : data_(data) {
+    if (data.size() < RECORD_HEADER_SIZE || !is_bundle(data)) { throw std::runtime_error("Bad bundle magic"); }
+    if (const auto version = get_u16(data.data() + 4); version == 0 || version > FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported bundle format version " + std::to_string(version));
+    }
+    const auto count = get_u64(data.data() + 8);
+    if (count > (data.size() - RECORD_HEADER_SIZE) / sizeof(std::uint64_t)) { throw std::runtime_error("Truncated bundle index"); }
+    const auto records_begin = RECORD_HEADER_SIZE + align_up(count * sizeof(std::uint64_t));
+    offsets_.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto offset = get_u64(data.data() + RECORD_HEADER_SIZE + i * sizeof(std::uint64_t));
+        if (offset < records_begin || offset > data.size() || data.size() - offset < RECORD_HEADER_SIZE || offset % RECORD_ALIGNMENT != 0) {
+            throw std::runtime_error("Corrupted bundle index entry " + std::to_string(i));
+        }
+        offsets_[i] = offset;
+    }
+}
+
+ByteSpan BundleView::record(std::size_t i) const {
+    if (i >= offsets_.size()) { throw std::out_of_range("Bundle index out of range"); }
+    return data_.subspan(offsets_[i]);
+}
+
+// ==== 文件映射 ====
+
+MappedFile::MappedFile(const std::string &path) {
+#ifdef QM_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { throw std::runtime_error("Cannot open " + path); }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot stat " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+        void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Cannot mmap " + path);
+        }
+        data_   = static_cast<const std::uint8_t *>(addr);
+        mapped_ = true;
+    }
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { throw std::runtime_error("Cannot open " + path); }
+    fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    data_ = fallback_.data();
+    size_ = fallback_.size();
+#endif
+}
+
+MappedFile::~MappedFile() { release(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)), mapped_(std::exchange(other.mapped_, false)), fallback_(std::move(other.fallback_)) {
+    if (!mapped_ && size_ > 0) { data_ = fallback_.data(); }
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        release();
+        data_     = std::exchange(other.data_, nullptr);
+        size_     = std::exchange(other.size_, 0);
+        mapped_   = std::exchange(other.mapped_, false);
+        fallback_ = std::move(other.fallback_);
+        if (!mapped_ && size_ > 0) { data_ = fallback_.data(); }
+    }
+    return *this;
+}
+
+void MappedFile::release() noexcept {
+#ifdef QM_HAS_MMAP
+    if (mapped_) { ::munmap(const_cast<std::uint8_t *>(data_), size_); }
+#endif
+    data_   = nullptr;
+    size_   = 0;
+    mapped_ = false;
+    fallback_.clear();
+}
+
+}// namespace qm::latin_square::binary
@@ -0,0 +1,132 @@
+#include "latin_square/canonical_form.h"
+
+#include "latin_square/zobrist.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace qm::latin_square {
+
+namespace {
+using Labels = std::vector<std::uint64_t>;
+
+// 有序对的组合键，两个位置不可交换
+std::uint64_t pair_key(const std::uint64_t first, const std::uint64_t second) { return zobrist::mix(zobrist::mix(first) + second); }
+
+// 把标签按取值压缩为类号 0..k-1（与对象编号无关），返回类数
+int compress(Labels &labels) {
+    auto values = labels;
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    for (auto &label: labels) { label = std::lower_bound(values.begin(), values.end(), label) - values.begin(); }
+    return static_cast<int>(values.size());
+}
+
+// 新标签由旧标签与相邻对象组合键的有序多重集决定
+void refine(const Labels &old_labels, std::vector<Labels> &neighbours, Labels &new_labels) {
+    for (size_t index = 0; index < old_labels.size(); ++index) {
+        auto &keys = neighbours[index];
+        std::sort(keys.begin(), keys.end());
+        auto label = zobrist::mix(old_labels[index]);
+        for (const auto key: keys) { label = zobrist::mix(label ^ key); }
+        new_labels[index] = label;
+        keys.clear();
+    }
+}
+
+// 按 (类号, 原编号) 排序，返回原编号 -> 规范编号
+std::vector<int> order_by(const Labels &labels) {
+    std::vector<int> order(labels.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&labels](const int a, const int b) { return labels[a] < labels[b]; });
+    std::vector<int> map(labels.size());
+    for (size_t position = 0; position < order.size(); ++position) { map[order[position]] = static_cast<int>(position); }
+    return map;
+}
+
+std::vector<int> inverse(const std::vector<int> &map) {
+    std::vector<int> inverse_map(map.size());
+    for (size_t index = 0; index < map.size(); ++index) { inverse_map[map[index]] = static_cast<int>(index); }
+    return inverse_map;
+}
+}// namespace
+
+CanonicalForm canonicalize(const Instance &instance) {
+    const int N = instance.size();
+    // 去重：同一格子以最后一次赋值为准
+    std::vector<int> grid(static_cast<size_t>(N) * N, -1);
+    for (const auto &assignment: instance.get_fixed()) {
+        if (assignment.row < 0 || assignment.row >= N || assignment.col < 0 || assignment.col >= N || assignment.num < 0 || assignment.num >= N) {
+            throw std::invalid_argument("Fixed cell out of range");
+        }
+        grid[static_cast<size_t>(assignment.row) * N + assignment.col] = assignment.num;
+    }
+    std::vector<Assignment> cells;
+    for (auto row = 0; row < N; ++row) {
+        for (auto col = 0; col < N; ++col) {
+            if (const int num = grid[static_cast<size_t>(row) * N + col]; num != -1) { cells.emplace_back(row, col, num); }
+        }
+    }
+
+    // 初始标签为出现次数
+    Labels rows(N, 0), cols(N, 0), symbols(N, 0);
+    for (const auto &cell: cells) {
+        ++rows[cell.row];
+        ++cols[cell.col];
+        ++symbols[cell.num];
+    }
+    int classes = compress(rows) + compress(cols) + compress(symbols);
+
+    // 迭代细化直到类数不再增加
+    std::vector<Labels> row_keys(N), col_keys(N), symbol_keys(N);
+    Labels next_rows(N), next_cols(N), next_symbols(N);
+    for (auto round = 0; round < 3 * N; ++round) {
+        for (const auto &cell: cells) {
+            row_keys[cell.row].push_back(pair_key(cols[cell.col], symbols[cell.num]));
+            col_keys[cell.col].push_back(pair_key(rows[cell.row], symbols[cell.num]));
+            symbol_keys[cell.num].push_back(pair_key(rows[cell.row], cols[cell.col]));
+        }
+        refine(rows, row_keys, next_rows);
+        refine(cols, col_keys, next_cols);
+        refine(symbols, symbol_keys, next_symbols);
+        const int next_classes = compress(next_rows) + compress(next_cols) + compress(next_symbols);
+        if (next_classes <= classes) { break; }
+        rows.swap(next_rows);
+        cols.swap(next_cols);
+        symbols.swap(next_symbols);
+        classes = next_classes;
+    }
+
+    CanonicalForm form;
+    form.row_map    = order_by(rows);
+    form.col_map    = order_by(cols);
+    form.symbol_map = order_by(symbols);
+    for (auto &cell: cells) { cell = Assignment(form.row_map[cell.row], form.col_map[cell.col], form.symbol_map[cell.num]); }
+    std::sort(cells.begin(), cells.end(), [](const Assignment &a, const Assignment &b) { return a.row != b.row ? a.row < b.row : a.col < b.col; });
+    form.hash = zobrist::mix(static_cast<std::uint64_t>(N));
+    for (const auto &cell: cells) { form.hash ^= zobrist::key(cell.row, cell.col, cell.num); }
+    form.instance = Instance(N, std::move(cells));
+    return form;
+}
+
+Solution CanonicalForm::to_canonical(const Solution &solution) const {
+    const auto N = solution.solution.size();
+    std::vector<std::vector<int>> grid(N, std::vector<int>(N));
+    for (size_t row = 0; row < N; ++row) {
+        for (size_t col = 0; col < N; ++col) { grid[row_map[row]][col_map[col]] = symbol_map[solution.solution[row][col]]; }
+    }
+    return Solution{std::move(grid)};
+}
+
+Solution CanonicalForm::from_canonical(const Solution &solution) const {
+    const auto N              = solution.solution.size();
+    const auto symbol_inverse = inverse(symbol_map);
+    std::vector<std::vector<int>> grid(N, std::vector<int>(N));
+    for (size_t row = 0; row < N; ++row) {
+        for (size_t col = 0; col < N; ++col) { grid[row][col] = symbol_inverse[solution.solution[row_map[row]][col_map[col]]]; }
+    }
+    return Solution{std::move(grid)};
+}
+
+}// namespace qm::latin_square
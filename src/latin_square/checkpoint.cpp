@@ -0,0 +1,315 @@
+#include "latin_square/checkpoint.h"
+
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace qm::latin_square {
+
+namespace {
+
+constexpr char CHECKPOINT_MAGIC[4] = {'L', 'S', 'Q', 'C'};
+constexpr std::size_t HEADER_SIZE  = 16;
+constexpr int MAX_ORDER            = 0xFFFF;
+
+constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+constexpr std::uint64_t FNV_PRIME  = 1099511628211ULL;
+
+std::uint64_t fnv1a(const std::uint8_t *data, std::size_t size, std::uint64_t hash = FNV_OFFSET) {
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+std::uint64_t fnv1a_u32(std::uint64_t hash, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        hash ^= static_cast<std::uint8_t>(v >> (8 * i));
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+class ByteWriter {
+public:
+    explicit ByteWriter(std::vector<std::uint8_t> &out) : out_(out) {}
+
+    void put_bytes(const void *data, std::size_t size) {
+        const auto *p = static_cast<const std::uint8_t *>(data);
+        out_.insert(out_.end(), p, p + size);
+    }
+    void put_u16(std::uint16_t v) { put_le(v, 2); }
+    void put_u32(std::uint32_t v) { put_le(v, 4); }
+    void put_u64(std::uint64_t v) { put_le(v, 8); }
+    void put_i32(int v) { put_u32(static_cast<std::uint32_t>(v)); }
+    void put_f64(double v) { put_u64(std::bit_cast<std::uint64_t>(v)); }
+
+private:
+    std::vector<std::uint8_t> &out_;
+
+    void put_le(std::uint64_t v, int bytes) {
+        for (int i = 0; i < bytes; ++i) { out_.push_back(static_cast<std::uint8_t>(v >> (8 * i))); }
+    }
+};
+
+class ByteReader {
+public:
+    ByteReader(const std::uint8_t *data, std::size_t size) : data_(data), size_(size) {}
+
+    const std::uint8_t *take(std::size_t bytes) {
+        if (size_ - pos_ < bytes) { throw std::runtime_error("Truncated checkpoint"); }
+        const auto *p = data_ + pos_;
+        pos_ += bytes;
+        return p;
+    }
+    std::uint16_t get_u16() { return static_cast<std::uint16_t>(get_le(2)); }
+    std::uint32_t get_u32() { return static_cast<std::uint32_t>(get_le(4)); }
+    std::uint64_t get_u64() { return get_le(8); }
+    int get_i32() { return static_cast<int>(get_u32()); }
+    double get_f64() { return std::bit_cast<double>(get_u64()); }
+
+private:
+    const std::uint8_t *data_;
+    std::size_t size_;
+    std::size_t pos_{0};
+
+    std::uint64_t get_le(int bytes) {
+        const auto *p   = take(bytes);
+        std::uint64_t v = 0;
+        for (int i = 0; i < bytes; ++i) { v |= static_cast<std::uint64_t>(p[i]) << (8 * i); }
+        return v;
+    }
+};
+
+void put_solution(ByteWriter &writer, const Solution &solution) {
+    writer.put_i32(solution.row_conflict);
+    writer.put_i32(solution.column_conflict);
+    writer.put_i32(solution.total_conflict);
+    writer.put_i32(solution.domain_conflict);
+    for (const auto &row: solution.solution) {
+        for (const auto color: row) { writer.put_u16(static_cast<std::uint16_t>(color)); }
+    }
+}
+
+Solution get_solution(ByteReader &reader, int n) {
+    Solution solution;
+    solution.row_conflict    = reader.get_i32();
+    solution.column_conflict = reader.get_i32();
+    solution.total_conflict  = reader.get_i32();
+    solution.domain_conflict = reader.get_i32();
+    solution.solution.assign(n, std::vector<int>(n));
+    for (auto &row: solution.solution) {
+        for (auto &color: row) {
+            color = reader.get_u16();
+            if (color >= n) { throw std::runtime_error("Invalid color in checkpoint"); }
+        }
+    }
+    solution.calculate_hash();
+    return solution;
+}
+
+void put_grid(ByteWriter &writer, const std::vector<std::vector<int>> &grid) {
+    for (const auto &row: grid) {
+        writer.put_u16(static_cast<std::uint16_t>(row.size()));
+        for (const auto col: row) { writer.put_u16(static_cast<std::uint16_t>(col)); }
+    }
+}
+
+std::vector<std::vector<int>> get_grid(ByteReader &reader, int n) {
+    std::vector<std::vector<int>> grid(n);
+    for (auto &row: grid) {
+        row.resize(reader.get_u16());
+        for (auto &col: row) {
+            col = reader.get_u16();
+            if (col >= n) { throw std::runtime_error("Invalid column in checkpoint"); }
+        }
+    }
+    return grid;
+}
+
+void put_ints(ByteWriter &writer, const std::vector<int> &values) {
+    writer.put_u32(static_cast<std::uint32_t>(values.size()));
+    for (const auto value: values) { writer.put_i32(value); }
+}
+
+std::vector<int> get_ints(ByteReader &reader) {
+    std::vector<int> values(reader.get_u32());
+    for (auto &value: values) { value = reader.get_i32(); }
+    return values;
+}
+
+void put_hashes(ByteWriter &writer, const std::vector<std::uint64_t> &hashes) {
+    writer.put_u32(static_cast<std::uint32_t>(hashes.size()));
+    for (const auto hash: hashes) { writer.put_u64(hash); }
+}
+
+std::vector<std::uint64_t> get_hashes(ByteReader &reader) {
+    std::vector<std::uint64_t> hashes(reader.get_u32());
+    for (auto &hash: hashes) { hash = reader.get_u64(); }
+    return hashes;
+}
+
+// 反应式禁忌期状态：存在标志 u32，随后 alpha、random_range、两个迭代计数、重访计数与两个整数序列
+void put_tenure(ByteWriter &writer, const std::optional<TabuTenureController::State> &tenure) {
+    writer.put_u32(tenure ? 1 : 0);
+    if (!tenure) { return; }
+    writer.put_f64(tenure->alpha);
+    writer.put_i32(tenure->random_range);
+    writer.put_u64(tenure->last_cycle_iteration);
+    writer.put_u64(tenure->last_improvement_iteration);
+    writer.put_i32(tenure->pending_revisits);
+    put_ints(writer, tenure->recent_costs);
+    put_ints(writer, tenure->match_runs);
+}
+
+std::optional<TabuTenureController::State> get_tenure(ByteReader &reader) {
+    if (reader.get_u32() == 0) { return std::nullopt; }
+    TabuTenureController::State tenure;
+    tenure.alpha                      = reader.get_f64();
+    tenure.random_range               = reader.get_i32();
+    tenure.last_cycle_iteration       = reader.get_u64();
+    tenure.last_improvement_iteration = reader.get_u64();
+    tenure.pending_revisits           = reader.get_i32();
+    tenure.recent_costs               = get_ints(reader);
+    tenure.match_runs                 = get_ints(reader);
+    return tenure;
+}
+
+}// namespace
+
+std::uint64_t instance_fingerprint(const Instance &instance) {
+    auto hash = fnv1a_u32(FNV_OFFSET, static_cast<std::uint32_t>(instance.size()));
+    for (const auto &assignment: instance.get_fixed()) {
+        hash = fnv1a_u32(hash, static_cast<std::uint32_t>(assignment.row));
+        hash = fnv1a_u32(hash, static_cast<std::uint32_t>(assignment.col));
+        hash = fnv1a_u32(hash, static_cast<std::uint32_t>(assignment.num));
+    }
+    return hash;
+}
+
+void SearchCheckpoint::check_instance(const Instance &instance) const {
+    if (n != instance.size()) {
+        throw std::runtime_error("Checkpoint order " + std::to_string(n) + " does not match instance order " + std::to_string(instance.size()));
+    }
+    if (fixed_count != instance.get_fixed().size()) {
+        throw std::runtime_error("Checkpoint fixed cell count " + std::to_string(fixed_count) + " does not match instance ("
+                                 + std::to_string(instance.get_fixed().size()) + ")");
+    }
+    if (instance_fingerprint != latin_square::instance_fingerprint(instance)) {
+        throw std::runtime_error("Checkpoint was saved for a different instance");
+    }
+}
+
+void encode_checkpoint(const SearchCheckpoint &checkpoint, std::vector<std::uint8_t> &out) {
+    if (checkpoint.n <= 0 || checkpoint.n > MAX_ORDER) { throw std::invalid_argument("Checkpoint order out of range"); }
+    const auto start = out.size();
+    ByteWriter writer(out);
+    writer.put_bytes(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    writer.put_u16(SearchCheckpoint::FORMAT_VERSION);
+    writer.put_u16(static_cast<std::uint16_t>(checkpoint.n));
+    writer.put_u32(checkpoint.fixed_count);
+    writer.put_u32(0);// 保留
+    writer.put_u64(checkpoint.instance_fingerprint);
+    writer.put_u64(checkpoint.iteration);
+    writer.put_i32(checkpoint.rt);
+    writer.put_i32(checkpoint.accu);
+    writer.put_f64(checkpoint.elapsed_seconds);
+    writer.put_i32(checkpoint.perturbation_stagnation);
+    writer.put_u32(checkpoint.improved_since_restart ? 1 : 0);
+    put_tenure(writer, checkpoint.tenure);
+    put_solution(writer, checkpoint.current);
+    put_solution(writer, checkpoint.best);
+    put_grid(writer, checkpoint.row_conflict_grid);
+    put_grid(writer, checkpoint.row_nonconflict_grid);
+    writer.put_u64(checkpoint.tabu.size());
+    for (const auto &[index, expiry]: checkpoint.tabu) {
+        writer.put_u32(index);
+        writer.put_u64(expiry);
+    }
+    put_hashes(writer, checkpoint.visited_older);
+    put_hashes(writer, checkpoint.visited_newer);
+    writer.put_i32(checkpoint.restarts_since_relink);
+    writer.put_u32(static_cast<std::uint32_t>(checkpoint.elites.size()));
+    for (const auto &elite: checkpoint.elites) { put_solution(writer, elite); }
+    writer.put_u32(static_cast<std::uint32_t>(checkpoint.rng_state.size()));
+    writer.put_bytes(checkpoint.rng_state.data(), checkpoint.rng_state.size());
+    writer.put_u64(fnv1a(out.data() + start, out.size() - start));
+}
+
+SearchCheckpoint decode_checkpoint(const std::vector<std::uint8_t> &data) {
+    if (data.size() < HEADER_SIZE + 8) { throw std::runtime_error("Truncated checkpoint"); }
+    if (std::memcmp(data.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) { throw std::runtime_error("Bad checkpoint magic"); }
+    const auto body_size = data.size() - 8;
+    ByteReader trailer(data.data() + body_size, 8);
+    if (trailer.get_u64() != fnv1a(data.data(), body_size)) { throw std::runtime_error("Checkpoint checksum mismatch"); }
+
+    ByteReader reader(data.data(), body_size);
+    reader.take(sizeof(CHECKPOINT_MAGIC));
+    const auto version = reader.get_u16();
+    if (version != SearchCheckpoint::FORMAT_VERSION) {
+        throw std::runtime_error("Unsupported checkpoint format version " + std::to_string(version));
+    }
+    SearchCheckpoint checkpoint;
+    checkpoint.n = reader.get_u16();
+    if (checkpoint.n == 0) { throw std::runtime_error("Invalid checkpoint order 0"); }
+    checkpoint.fixed_count = reader.get_u32();
+    reader.get_u32();
+    checkpoint.instance_fingerprint    = reader.get_u64();
+    checkpoint.iteration               = reader.get_u64();
+    checkpoint.rt                      = reader.get_i32();
+    checkpoint.accu                    = reader.get_i32();
+    checkpoint.elapsed_seconds         = reader.get_f64();
+    checkpoint.perturbation_stagnation = reader.get_i32();
+    checkpoint.improved_since_restart  = reader.get_u32() != 0;
+    checkpoint.tenure                  = get_tenure(reader);
+    checkpoint.current                 = get_solution(reader, checkpoint.n);
+    checkpoint.best                    = get_solution(reader, checkpoint.n);
+    checkpoint.row_conflict_grid       = get_grid(reader, checkpoint.n);
+    checkpoint.row_nonconflict_grid    = get_grid(reader, checkpoint.n);
+    const auto tabu_count              = reader.get_u64();
+    const auto cells                   = static_cast<std::uint64_t>(checkpoint.n) * checkpoint.n * checkpoint.n;
+    if (tabu_count > cells) { throw std::runtime_error("Invalid checkpoint tabu entry count"); }
+    checkpoint.tabu.resize(tabu_count);
+    for (auto &[index, expiry]: checkpoint.tabu) {
+        index  = reader.get_u32();
+        expiry = reader.get_u64();
+        if (index >= cells) { throw std::runtime_error("Invalid checkpoint tabu entry"); }
+    }
+    checkpoint.visited_older         = get_hashes(reader);
+    checkpoint.visited_newer         = get_hashes(reader);
+    checkpoint.restarts_since_relink = reader.get_i32();
+    checkpoint.elites.resize(reader.get_u32());
+    for (auto &elite: checkpoint.elites) { elite = get_solution(reader, checkpoint.n); }
+    const auto rng_size = reader.get_u32();
+    const auto *rng     = reader.take(rng_size);
+    checkpoint.rng_state.assign(reinterpret_cast<const char *>(rng), rng_size);
+    return checkpoint;
+}
+
+void save_checkpoint(const std::string &path, const SearchCheckpoint &checkpoint) {
+    std::vector<std::uint8_t> bytes;
+    encode_checkpoint(checkpoint, bytes);
+    const auto temp_path = path + ".tmp";
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size())) || !out.flush()) {
+            throw std::runtime_error("Failed to write checkpoint " + temp_path);
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) { throw std::runtime_error("Failed to move checkpoint into place: " + ec.message()); }
+}
+
+SearchCheckpoint load_checkpoint(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { throw std::runtime_error("Cannot open checkpoint " + path); }
+    const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    return decode_checkpoint(bytes);
+}
+
+}// namespace qm::latin_square
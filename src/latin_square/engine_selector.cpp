@@ -0,0 +1,74 @@
+#include "latin_square/engine_selector.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace qm::latin_square {
+
+namespace {
+std::string_view trim(std::string_view text) {
+    const auto first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos) { return {}; }
+    const auto last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+template<typename T>
+T parse_value(const std::string &key, const std::string &value) {
+    try {
+        size_t used = 0;
+        T parsed{};
+        if constexpr (std::is_same_v<T, int>) {
+            parsed = std::stoi(value, &used);
+        } else {
+            parsed = std::stod(value, &used);
+        }
+        if (used == value.size()) { return parsed; }
+    } catch (const std::exception &) {}
+    throw std::runtime_error("Invalid value for selector threshold " + key + ": " + value);
+}
+}// namespace
+
+EngineKind select_engine(const InstanceFeatures &features, const SelectorThresholds &thresholds, const unsigned hardware_threads) {
+    if (features.free_cells <= thresholds.exact_max_free_cells) { return EngineKind::EXACT; }
+    if (features.n >= thresholds.portfolio_min_n && features.fill_ratio >= thresholds.portfolio_min_fill && features.fill_ratio <= thresholds.portfolio_max_fill &&
+        hardware_threads >= static_cast<unsigned>(thresholds.portfolio_min_threads)) {
+        return EngineKind::PORTFOLIO;
+    }
+    return EngineKind::TABU;
+}
+
+SelectorThresholds load_selector_thresholds(const std::string &path) {
+    std::ifstream in(path);
+    if (!in) { throw std::runtime_error("Cannot open selector config " + path); }
+    SelectorThresholds thresholds;
+    std::string line;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+        ++line_number;
+        const auto content = trim(std::string_view(line).substr(0, line.find('#')));
+        if (content.empty()) { continue; }
+        const auto equals = content.find('=');
+        if (equals == std::string_view::npos) { throw std::runtime_error(path + ":" + std::to_string(line_number) + ": expected key = value"); }
+        const std::string key(trim(content.substr(0, equals)));
+        const std::string value(trim(content.substr(equals + 1)));
+        if (key == "exact_max_free_cells") {
+            thresholds.exact_max_free_cells = parse_value<int>(key, value);
+        } else if (key == "portfolio_min_n") {
+            thresholds.portfolio_min_n = parse_value<int>(key, value);
+        } else if (key == "portfolio_min_fill") {
+            thresholds.portfolio_min_fill = parse_value<double>(key, value);
+        } else if (key == "portfolio_max_fill") {
+            thresholds.portfolio_max_fill = parse_value<double>(key, value);
+        } else if (key == "portfolio_min_threads") {
+            thresholds.portfolio_min_threads = parse_value<int>(key, value);
+        } else {
+            throw std::runtime_error(path + ":" + std::to_string(line_number) + ": unknown selector threshold " + key);
+        }
+    }
+    return thresholds;
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,224 @@
+#include "latin_square/exact_search.h"
+
+#include <bit>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+namespace qm::latin_square {
+
+namespace {
+constexpr unsigned long long CHECK_INTERVAL = 1024;// 每隔多少个节点检查一次时间限制与停止标志
+
+template<size_t W>
+int popcount(const std::array<std::uint64_t, W> &mask) {
+    int count = 0;
+    for (const auto word: mask) { count += std::popcount(word); }
+    return count;
+}
+
+template<size_t W>
+bool any(const std::array<std::uint64_t, W> &mask) {
+    for (const auto word: mask) {
+        if (word != 0) { return true; }
+    }
+    return false;
+}
+
+template<size_t W>
+void set_bit(std::array<std::uint64_t, W> &mask, const int bit) {
+    mask[bit / 64] |= 1ULL << (bit % 64);
+}
+
+template<size_t W>
+void reset_bit(std::array<std::uint64_t, W> &mask, const int bit) {
+    mask[bit / 64] &= ~(1ULL << (bit % 64));
+}
+
+template<size_t W>
+bool test_bit(const std::array<std::uint64_t, W> &mask, const int bit) {
+    return (mask[bit / 64] >> (bit % 64) & 1ULL) != 0;
+}
+}// namespace
+
+int ExactSearch::free_cells(const LatinSquare &latin_square) { return latin_square.free_cell_count(); }
+
+void ExactSearch::search(const LatinSquare &latin_square, const Solution &solution, const unsigned long long max_iteration, const double time_limit_seconds) {
+    start_time_         = std::chrono::high_resolution_clock::now();
+    best_solution_      = solution;
+    nodes_              = 0;
+    next_check_         = CHECK_INTERVAL;
+    max_nodes_          = max_iteration;
+    time_limit_seconds_ = time_limit_seconds;
+    aborted_            = false;
+    status_             = ExactStatus::UNKNOWN;
+    telemetry_.reset();
+
+    if (prepare_(latin_square) && dfs_()) {
+        status_ = ExactStatus::SOLVED;
+        std::vector<std::vector<int>> grid(N_, std::vector<int>(N_));
+        for (auto row = 0; row < N_; ++row) {
+            for (auto col = 0; col < N_; ++col) { grid[row][col] = grid_[row * N_ + col]; }
+        }
+        best_solution_ = Solution{std::move(grid)};
+        ++telemetry_.improvements;
+        if (on_improvement_) { on_improvement_(best_solution_, nodes_); }
+    } else if (!aborted_) {
+        status_ = ExactStatus::INFEASIBLE;
+    }
+
+    if (config_.verbose) {
+        const auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time_).count();
+        const char *result = status_ == ExactStatus::SOLVED ? "找到可行解" : status_ == ExactStatus::INFEASIBLE ? "证明无解" : "未得出结论";
+        std::clog << "精确搜索" << result << "，节点数 " << nodes_ << "，回溯 " << telemetry_.backtracks << "，用时 " << std::fixed << std::setprecision(3) << elapsed << " s"
+                  << std::endl;
+    }
+}
+
+bool ExactSearch::prepare_(const LatinSquare &latin_square) {
+    N_               = latin_square.get_instance_size();
+    const auto cells = static_cast<size_t>(N_) * N_;
+    grid_.assign(cells, -1);
+    domain_.assign(cells, Mask{});
+    domain_size_.assign(cells, 0);
+    row_used_.assign(N_, Mask{});
+    col_used_.assign(N_, Mask{});
+    free_.clear();
+    free_slot_.assign(cells, -1);
+
+    std::vector<std::pair<int, int>> fixed;
+    for (auto row = 0; row < N_; ++row) {
+        for (auto col = 0; col < N_; ++col) {
+            const int cell     = row * N_ + col;
+            const auto &domain = latin_square.color_domain_(row, col);
+            for (auto color = 0; color < N_; ++color) {
+                if (domain.bits[color]) { set_bit(domain_[cell], color); }
+            }
+            domain_size_[cell] = domain.size;
+            if (domain.size == 0) { return false; }
+            if (domain.size == 1) {
+                fixed.emplace_back(cell, domain.get_first_element());
+            } else {
+                free_slot_[cell] = static_cast<int>(free_.size());
+                free_.push_back(cell);
+            }
+        }
+    }
+    free_count_ = static_cast<int>(free_.size());
+    // 实例无解时化简可能改写预填格的颜色域，预填格的颜色域必须恰好是预填颜色
+    for (const auto &assignment: latin_square.instance_->get_fixed()) {
+        const auto &domain = latin_square.color_domain_(assignment.row, assignment.col);
+        if (domain.size != 1 || !domain.bits[assignment.num]) { return false; }
+    }
+    // 固定格（含化简推出的）直接赋值，同行或同列重复即无解
+    for (const auto &[cell, color]: fixed) {
+        if (test_bit(row_used_[cell / N_], color) || test_bit(col_used_[cell % N_], color)) { return false; }
+        grid_[cell] = color;
+        set_bit(row_used_[cell / N_], color);
+        set_bit(col_used_[cell % N_], color);
+    }
+    for (auto i = 0; i < free_count_; ++i) {
+        if (!forward_check_(free_[i] / N_, free_[i] % N_)) { return false; }
+    }
+    return true;
+}
+
+ExactSearch::Mask ExactSearch::candidates_(const int cell) const {
+    const auto &row_used = row_used_[cell / N_];
+    const auto &col_used = col_used_[cell % N_];
+    Mask mask            = domain_[cell];
+    for (auto w = 0; w < WORDS; ++w) { mask[w] &= ~(row_used[w] | col_used[w]); }
+    return mask;
+}
+
+bool ExactSearch::forward_check_(const int row, const int col) const {
+    // 同行：每个未赋值格都要有候选颜色，且每个尚未使用的颜色都要有格子可放
+    Mask reachable{};
+    for (auto c = 0; c < N_; ++c) {
+        const int cell = row * N_ + c;
+        if (grid_[cell] >= 0) { continue; }
+        const auto mask = candidates_(cell);
+        if (!any(mask)) { return false; }
+        for (auto w = 0; w < WORDS; ++w) { reachable[w] |= mask[w]; }
+    }
+    if (popcount(reachable) + popcount(row_used_[row]) < N_) { return false; }
+    // 同列
+    reachable = Mask{};
+    for (auto r = 0; r < N_; ++r) {
+        const int cell = r * N_ + col;
+        if (grid_[cell] >= 0) { continue; }
+        const auto mask = candidates_(cell);
+        if (!any(mask)) { return false; }
+        for (auto w = 0; w < WORDS; ++w) { reachable[w] |= mask[w]; }
+    }
+    return popcount(reachable) + popcount(col_used_[col]) >= N_;
+}
+
+void ExactSearch::assign_(const int cell, const int color) {
+    grid_[cell] = color;
+    set_bit(row_used_[cell / N_], color);
+    set_bit(col_used_[cell % N_], color);
+    // 把格子换到未赋值部分的末尾再截掉；回溯按后进先出的顺序恢复
+    const int slot = free_slot_[cell];
+    const int last = free_[free_count_ - 1];
+    std::swap(free_[slot], free_[free_count_ - 1]);
+    free_slot_[last] = slot;
+    free_slot_[cell] = free_count_ - 1;
+    --free_count_;
+}
+
+void ExactSearch::unassign_(const int cell, const int color) {
+    grid_[cell] = -1;
+    reset_bit(row_used_[cell / N_], color);
+    reset_bit(col_used_[cell % N_], color);
+    ++free_count_;
+}
+
+bool ExactSearch::dfs_() {
+    if (free_count_ == 0) { return true; }
+    if (out_of_budget_()) { return false; }
+
+    // MRV：候选颜色最少的格子，相同时取颜色域较小者
+    int best_cell = -1;
+    int best_size = std::numeric_limits<int>::max();
+    for (auto i = 0; i < free_count_; ++i) {
+        const int cell = free_[i];
+        const int size = popcount(candidates_(cell));
+        if (size == 0) { return false; }
+        if (size < best_size || (size == best_size && domain_size_[cell] < domain_size_[best_cell])) {
+            best_cell = cell;
+            best_size = size;
+        }
+    }
+
+    const auto mask = candidates_(best_cell);
+    for (auto w = 0; w < WORDS; ++w) {
+        for (auto bits = mask[w]; bits != 0; bits &= bits - 1) {
+            const int color = w * 64 + std::countr_zero(bits);
+            ++nodes_;
+            assign_(best_cell, color);
+            if (forward_check_(best_cell / N_, best_cell % N_) && dfs_()) { return true; }
+            unassign_(best_cell, color);
+            ++telemetry_.backtracks;
+            if (aborted_) { return false; }
+        }
+    }
+    return false;
+}
+
+bool ExactSearch::out_of_budget_() {
+    if (aborted_) { return true; }
+    if (nodes_ >= max_nodes_) {
+        aborted_ = true;
+    } else if (nodes_ >= next_check_) {
+        // 前向检查失败的节点不会经过这里，按阈值而不是整除判断
+        next_check_ = nodes_ + CHECK_INTERVAL;
+        const bool stopped = stop_flag_ != nullptr && stop_flag_->load(std::memory_order_relaxed);
+        const auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time_).count();
+        aborted_           = stopped || (time_limit_seconds_ > 0 && elapsed >= time_limit_seconds_);
+    }
+    return aborted_;
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,85 @@
+#include "latin_square/incremental.h"
+
+#include <algorithm>
+#include <istream>
+#include <stdexcept>
+#include <string>
+
+namespace qm::latin_square {
+
+Instance apply_delta(const Instance &instance, const InstanceDelta &delta) {
+    const int N         = instance.size();
+    const auto in_range = [N](const Assignment &assignment) {
+        return assignment.row >= 0 && assignment.row < N && assignment.col >= 0 && assignment.col < N && assignment.num >= 0 && assignment.num < N;
+    };
+    // 以格子为下标合并，同一格子以最后一次赋值为准
+    std::vector<int> grid(static_cast<size_t>(N) * N, -1);
+    for (const auto &assignment: instance.get_fixed()) {
+        if (!in_range(assignment)) { throw std::invalid_argument("Fixed cell out of range"); }
+        grid[static_cast<size_t>(assignment.row) * N + assignment.col] = assignment.num;
+    }
+    for (const auto &assignment: delta.removed) {
+        if (assignment.row < 0 || assignment.row >= N || assignment.col < 0 || assignment.col >= N) { throw std::invalid_argument("Removed cell out of range"); }
+        grid[static_cast<size_t>(assignment.row) * N + assignment.col] = -1;
+    }
+    for (const auto &assignment: delta.added) {
+        if (!in_range(assignment)) { throw std::invalid_argument("Added cell out of range"); }
+        grid[static_cast<size_t>(assignment.row) * N + assignment.col] = assignment.num;
+    }
+
+    std::vector<Assignment> fixed;
+    for (auto row = 0; row < N; ++row) {
+        for (auto col = 0; col < N; ++col) {
+            if (const int num = grid[static_cast<size_t>(row) * N + col]; num != -1) { fixed.emplace_back(row, col, num); }
+        }
+    }
+    return Instance(N, std::move(fixed));
+}
+
+Solution repair_solution(const LatinSquare &latin_square, const Solution &previous, int *swaps) {
+    const int N = latin_square.get_instance_size();
+    if (previous.solution.size() != static_cast<size_t>(N)) { throw std::invalid_argument("Previous solution size does not match the instance"); }
+    auto grid = previous.solution;
+    // position[color]: 该颜色在当前行中的列号
+    std::vector<int> position(N);
+    int swap_count = 0;
+    for (auto row = 0; row < N; ++row) {
+        auto &cells = grid[row];
+        if (cells.size() != static_cast<size_t>(N)) { throw std::invalid_argument("Previous solution row size does not match the instance"); }
+        std::fill(position.begin(), position.end(), -1);
+        for (auto col = 0; col < N; ++col) {
+            const int color = cells[col];
+            if (color < 0 || color >= N || position[color] != -1) { throw std::invalid_argument("Previous solution row is not a permutation"); }
+            position[color] = col;
+        }
+        // 固定格只占非固定格以外的列
+        auto free_it = latin_square.free_cols(row).begin();
+        for (auto col = 0; col < N; ++col) {
+            if (free_it != latin_square.free_cols(row).end() && *free_it == col) {
+                ++free_it;
+                continue;
+            }
+            const int color = latin_square.color_domain_(row, col).get_first_element();
+            if (cells[col] == color) { continue; }
+            const int other = position[color];
+            position[cells[col]] = other;
+            position[color]      = col;
+            std::swap(cells[col], cells[other]);
+            ++swap_count;
+        }
+    }
+    if (swaps != nullptr) { *swaps = swap_count; }
+    return Solution{std::move(grid)};
+}
+
+Solution read_text_solution(std::istream &is, const int n) {
+    std::vector<std::vector<int>> grid(n, std::vector<int>(n));
+    for (auto &row: grid) {
+        for (auto &cell: row) {
+            if (!(is >> cell)) { throw std::runtime_error("Incomplete solution: expected " + std::to_string(n) + " x " + std::to_string(n) + " integers"); }
+        }
+    }
+    return Solution{std::move(grid)};
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,38 @@
+#include "latin_square/instance_features.h"
+
+#include <ostream>
+
+namespace qm::latin_square {
+
+InstanceFeatures extract_features(const LatinSquare &latin_square) {
+    InstanceFeatures features;
+    const int N                = latin_square.get_instance_size();
+    const auto &color_domain   = latin_square.color_domain_;
+    features.n                 = N;
+    features.preset_cells      = static_cast<int>(latin_square.instance_->get_fixed().size());
+    features.fill_ratio        = N > 0 ? static_cast<double>(features.preset_cells) / (static_cast<double>(N) * N) : 0.0;
+    features.fixed_cells       = color_domain.fixed_num();
+    features.total_domain_size = color_domain.total_domain_size();
+    features.domain_histogram.assign(N + 1, 0);
+
+    long long free_domain_size = 0;
+    for (auto row = 0; row < N; ++row) {
+        for (auto col = 0; col < N; ++col) {
+            const int size = color_domain(row, col).size;
+            ++features.domain_histogram[size];
+            if (size != 1) {
+                ++features.free_cells;
+                free_domain_size += size;
+            }
+        }
+    }
+    features.mean_free_domain_size = features.free_cells > 0 ? static_cast<double>(free_domain_size) / features.free_cells : 0.0;
+    return features;
+}
+
+std::ostream &operator<<(std::ostream &os, const InstanceFeatures &features) {
+    return os << "n=" << features.n << " preset=" << features.preset_cells << " fill=" << features.fill_ratio << " fixed=" << features.fixed_cells
+              << " free=" << features.free_cells << " domain_total=" << features.total_domain_size << " domain_mean=" << features.mean_free_domain_size;
+}
+
+}// namespace qm::latin_square
@@ -5,67 +5,145 @@
 
 #include "utils/RandomGenerator.h"
 
+#include <algorithm>
 #include <chrono>
 #include <iomanip>
 #include <limits>
 
 namespace qm::latin_square {
-void LocalSearch::search(const LatinSquare &latin_square, const Solution &solution, const unsigned long long max_iteration, const int time_limit_seconds) {
-    // 记录开始时间
-    auto start_time = std::chrono::high_resolution_clock::now();
-
+void LocalSearch::search(const LatinSquare &latin_square, const Solution &solution, const unsigned long long max_iteration, const double time_limit_seconds) {
+    prepare_workspace_(latin_square.get_instance_size());
     current_solution_ = solution;
     best_solution_    = solution;
     iteration_        = 0;
-    tabu_list_        = TabuList{latin_square.get_instance_size()};
-    evaluator_        = Evaluator{latin_square, solution};
+    tabu_list_.reset(latin_square.get_instance_size());
+    evaluator_.reset(latin_square, solution);
     accu              = 0;
-    rt                = 10;
+    rt                = config_.restart_threshold;
+    elapsed_offset_   = 0;
+    perturbation_.set_config(config_.perturbation);
+    improved_since_restart_ = false;
+    elites_.set_capacity(config_.relinking.elite_size);
+    elites_.clear();
+    restarts_since_relink_ = 0;
+    tenure_.reset(config_.tenure, config_.tabu_alpha, config_.tabu_random_range);
+    reset_visited_();
+    telemetry_.reset();
 
     // 初始化冲突节点集合（只在开始时执行一次）
-    set_row_conflict_grid_(current_solution_);
+    row_grid_.rebuild(latin_square, evaluator_, current_solution_);
+
+    run_(latin_square, max_iteration, time_limit_seconds);
+    // 搜索返回后不再引用调用方的拉丁方
+    evaluator_.detach();
+}
+
+void LocalSearch::resume(const LatinSquare &latin_square, const SearchCheckpoint &checkpoint, const unsigned long long max_iteration, const double time_limit_seconds) {
+    checkpoint.check_instance(*latin_square.instance_);
+    prepare_workspace_(checkpoint.n);
+    current_solution_ = checkpoint.current;
+    best_solution_    = checkpoint.best;
+    iteration_        = checkpoint.iteration;
+    tabu_list_.restore(checkpoint.n, checkpoint.tabu);
+    // 记录表由当前解重建，只依赖计数，与增量维护的结果相同
+    evaluator_.reset(latin_square, current_solution_);
+    accu            = checkpoint.accu;
+    rt              = checkpoint.rt;
+    elapsed_offset_ = checkpoint.elapsed_seconds;
+    perturbation_.set_config(config_.perturbation);
+    perturbation_.set_stagnation(checkpoint.perturbation_stagnation);
+    improved_since_restart_ = checkpoint.improved_since_restart;
+    elites_.restore(checkpoint.elites);
+    elites_.set_capacity(config_.relinking.elite_size);
+    restarts_since_relink_ = checkpoint.restarts_since_relink;
+    if (checkpoint.tenure) {
+        tenure_.restore(config_.tenure, *checkpoint.tenure);
+    } else {
+        tenure_.reset(config_.tenure, config_.tabu_alpha, config_.tabu_random_range);
+    }
+    reset_visited_();
+    visited_.restore_generations(checkpoint.visited_older, checkpoint.visited_newer);
+    telemetry_.reset();
+
+    // 冲突节点集合按保存的元素顺序恢复，保证 find_move 的平局选择一致
+    row_grid_.restore(latin_square, evaluator_, current_solution_, checkpoint.row_conflict_grid, checkpoint.row_nonconflict_grid);
+    qm::randomGenerator().restoreState(checkpoint.rng_state);
+
+    if (config_.verbose) { std::clog << "从检查点恢复: 迭代 " << iteration_ << "，最优冲突数 " << best_solution_.total_conflict << std::endl; }
+    run_(latin_square, max_iteration, time_limit_seconds);
+    evaluator_.detach();
+}
+
+void LocalSearch::run_(const LatinSquare &latin_square, const unsigned long long max_iteration, const double time_limit_seconds) {
+    // 记录开始时间
+    auto start_time           = std::chrono::high_resolution_clock::now();
+    const bool checkpointing  = on_checkpoint_ && checkpoint_interval_ > 0;
+    double next_checkpoint_at = checkpoint_interval_;
 
     while (iteration_ < max_iteration) {
-        // 检查时间限制
-        if (time_limit_seconds > 0) {
+        // 检查外部停止标志
+        if (stop_flag_ != nullptr && stop_flag_->load(std::memory_order_relaxed)) {
+            if (config_.verbose) { std::clog << "收到停止请求，搜索终止，最终冲突数: " << best_solution_.total_conflict << std::endl; }
+            emit_checkpoint_(latin_square, std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count());
+            return;
+        }
+        // 检查时间限制与检查点间隔
+        if (time_limit_seconds > 0 || checkpointing) {
             auto current_time                     = std::chrono::high_resolution_clock::now();
             std::chrono::duration<double> elapsed = current_time - start_time;
-            if (elapsed.count() >= time_limit_seconds) {
-                std::clog << "达到时间限制 " << time_limit_seconds << " 秒，搜索终止" << std::endl;
-                std::clog << "最终冲突数: " << best_solution_.total_conflict << std::endl;
+            if (time_limit_seconds > 0 && elapsed.count() >= time_limit_seconds) {
+                if (config_.verbose) {
+                    std::clog << "达到时间限制 " << time_limit_seconds << " 秒，搜索终止" << std::endl;
+                    std::clog << "最终冲突数: " << best_solution_.total_conflict << std::endl;
+                    std::clog << "遥测: " << telemetry_ << std::endl;
+                }
+                emit_checkpoint_(latin_square, elapsed.count());
                 return;
             }
+            if (checkpointing && elapsed.count() >= next_checkpoint_at) {
+                emit_checkpoint_(latin_square, elapsed.count());
+                next_checkpoint_at = elapsed.count() + checkpoint_interval_;
+            }
         }
         auto move = find_move();
         make_move(move);
 
-        if (current_solution_ <= best_solution_) { best_solution_ = current_solution_; }
+        const bool improved  = update_best_();
+        const bool revisited = visited_.visit(current_solution_.hash);
+        tenure_.observe(iteration_, current_solution_.total_conflict, improved, revisited, telemetry_);
         // if (iteration_ % 10000 == 0) { std::clog << "Iteration: " << iteration_ << " conflict = " << current_solution_.total_conflict << std::endl; }
 
         if (current_solution_.total_conflict == 0) {
             // 计算求解时间
             auto end_time                         = std::chrono::high_resolution_clock::now();
             std::chrono::duration<double> elapsed = end_time - start_time;
-            std::clog << "Iteration: " << iteration_ << " conflict = 0, return." << std::endl;
-            std::clog << "求解时间: " << std::fixed << std::setprecision(3) << elapsed.count() << " s" << std::endl;
+            if (config_.verbose) {
+                std::clog << "Iteration: " << iteration_ << " conflict = 0, return." << std::endl;
+                std::clog << "求解时间: " << std::fixed << std::setprecision(3) << elapsed.count() << " s" << std::endl;
+                std::clog << "遥测: " << telemetry_ << std::endl;
+            }
             return;
         }
         if (current_solution_ - best_solution_ > rt) {
-            std::cerr << "重启" << std::endl;
+            if (config_.verbose) { std::cerr << "重启" << std::endl; }
+            ++telemetry_.restarts;
             // 清空禁忌表
-            tabu_list_.clear_tabu();
-            // 使用历史最优解替换当前解
-            current_solution_ = best_solution_;
-            evaluator_        = Evaluator{latin_square, current_solution_};
-            // 重启后需要重新计算冲突节点集合
-            set_row_conflict_grid_(current_solution_);
-            // 扰动 todo
+            tabu_list_.clear_tabu(iteration_);
+            // 重启后回到旧轨迹附近属于预期，重访记录从此重新开始
+            visited_.clear();
+            if (!relink_(latin_square)) {
+                // 使用历史最优解替换当前解
+                current_solution_ = best_solution_;
+                evaluator_.reset(latin_square, current_solution_);
+                // 重启后需要重新计算冲突节点集合
+                row_grid_.rebuild(latin_square, evaluator_, current_solution_);
+                // 扰动：从历史最优解出发施加若干次行内交换
+                perturb_(latin_square);
+            }
             // 如果重启阈值没有到达上限
-            static constexpr int rtub  = 15;
-            static constexpr int accub = 1000;
-            if (rt < rtub) {
+            if (rt < config_.restart_threshold_upper) {
                 ++accu;// 累计重启次数加一
-                if (accu == accub) {
+                if (accu >= config_.restart_accumulate_upper) {
                     ++rt;// 增大重启阈值
                     accu = 0;
                 }
@@ -77,144 +155,131 @@ void LocalSearch::search(const LatinSquare &latin_square, const Solution &soluti
     // 搜索结束，输出总时间
     auto end_time                         = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = end_time - start_time;
-    std::clog << "搜索结束，总时间: " << std::fixed << std::setprecision(3) << elapsed.count() << " s" << std::endl;
-    std::clog << "最终冲突数: " << best_solution_.total_conflict << std::endl;
+    emit_checkpoint_(latin_square, elapsed.count());
+    if (config_.verbose) {
+        std::clog << "搜索结束，总时间: " << std::fixed << std::setprecision(3) << elapsed.count() << " s" << std::endl;
+        std::clog << "最终冲突数: " << best_solution_.total_conflict << std::endl;
+        std::clog << "遥测: " << telemetry_ << std::endl;
+    }
 }
 
+namespace {
+// find_move 中一类移动（禁忌或非禁忌）的当前最优者：先比一级、再比二级评估函数，完全相同时蓄水池抽样
+struct MoveChoice {
+    Move move{-1, -1, -1};
+    int delta1{std::numeric_limits<int>::max()};
+    int delta2{std::numeric_limits<int>::max()};
+    int num{0};
+};
+}// namespace
+
 Move LocalSearch::find_move() {
-    // 遍历每一行
     const int N = static_cast<int>(current_solution_.solution.size());
-    Move best_non_tabu_move{-1, -1, -1};
-    Move best_tabu_move{-1, -1, -1};
-    int best_non_tabu_move_delta1 = std::numeric_limits<int>::max();
-    int best_non_tabu_move_delta2 = std::numeric_limits<int>::max();
-    int best_tabu_move_delta1     = std::numeric_limits<int>::max();
-    int best_tabu_move_delta2     = std::numeric_limits<int>::max();
-    int non_tabu_move_num         = 0;
-    int tabu_move_num             = 0;
+    MoveChoice best_non_tabu;
+    MoveChoice best_tabu;
+
+    const auto consider = [this, &best_non_tabu, &best_tabu](const Move &move) {
+        const auto move_delta1 = evaluator_.evaluate_conflict_delta(current_solution_, move);
+        auto &best             = is_tabu(move, current_solution_.total_conflict + move_delta1) ? best_tabu : best_non_tabu;
+        if (move_delta1 < best.delta1) {
+            // 一级评估函数更优，计算二级评估函数
+            best.delta1 = move_delta1;
+            best.delta2 = evaluator_.evaluate_domain_delta(current_solution_, move);
+            best.move   = move;
+            best.num    = 1;
+        } else if (move_delta1 == best.delta1) {
+            // 一级评估函数相同，计算二级评估函数进行比较
+            const auto move_delta2 = evaluator_.evaluate_domain_delta(current_solution_, move);
+            if (move_delta2 < best.delta2) {
+                best.delta2 = move_delta2;
+                best.move   = move;
+                best.num    = 1;
+            } else if (move_delta2 == best.delta2) {
+                best.num++;
+                if (randomInt(best.num) == 0) { best.move = move; }
+            }
+        }
+    };
+    // 特赦规则：如果禁忌移动比历史最优解更好且优于最佳非禁忌移动，则选择禁忌移动
+    const auto aspirated = [this, &best_non_tabu, &best_tabu] {
+        return current_solution_.total_conflict + best_tabu.delta1 < best_solution_.total_conflict && best_tabu.delta1 < best_non_tabu.delta1;
+    };
+
+    // 大规模实例先只扫描抽样冲突格参与的交换，有改进移动时直接采用
+    if (N >= config_.candidates.min_n && sample_candidates_()) {
+        for (const auto &[row, col1]: candidate_sample_) {
+            for (const auto col2: row_grid_.conflict(row)) {
+                if (col2 != col1) { consider(Move{row, col1, col2}); }
+            }
+            for (const auto col2: row_grid_.nonconflict(row)) { consider(Move{row, col1, col2}); }
+        }
+        if (aspirated()) {
+            ++telemetry_.candidate_scans;
+            return best_tabu.move;
+        }
+        if (best_non_tabu.move.row_id != -1 && best_non_tabu.delta1 < 0) {
+            ++telemetry_.candidate_scans;
+            return best_non_tabu.move;
+        }
+        ++telemetry_.candidate_fallbacks;
+        best_non_tabu = MoveChoice{};
+        best_tabu     = MoveChoice{};
+    }
 
+    // 遍历每一行
     for (auto row = 0; row < N; ++row) {
+        const auto &conflict_cols    = row_grid_.conflict(row);
+        const auto &nonconflict_cols = row_grid_.nonconflict(row);
         // 冲突节点 - 冲突节点
-        for (auto i = 0; i < row_conflict_grid_[row].size(); ++i) {
-            const auto col1 = row_conflict_grid_[row][i];
-            for (auto j = i + 1; j < row_conflict_grid_[row].size(); ++j) {
-                const auto col2 = row_conflict_grid_[row][j];
-                Move move{row, col1, col2};
-
-                auto move_delta1 = evaluator_.evaluate_conflict_delta(current_solution_, move);
-
-                if (is_tabu(move, current_solution_.total_conflict + move_delta1)) {
-                    // 禁忌移动
-                    if (move_delta1 < best_tabu_move_delta1) {
-                        // 一级评估函数更优，计算二级评估函数
-                        auto move_delta2      = evaluator_.evaluate_domain_delta(current_solution_, move);
-                        best_tabu_move_delta1 = move_delta1;
-                        best_tabu_move_delta2 = move_delta2;
-                        best_tabu_move        = move;
-                        tabu_move_num         = 1;
-                    } else if (move_delta1 == best_tabu_move_delta1) {
-                        // 一级评估函数相同，计算二级评估函数进行比较
-                        auto move_delta2 = evaluator_.evaluate_domain_delta(current_solution_, move);
-                        if (move_delta2 < best_tabu_move_delta2) {
-                            best_tabu_move_delta2 = move_delta2;
-                            best_tabu_move        = move;
-                            tabu_move_num         = 1;
-                        } else if (move_delta2 == best_tabu_move_delta2) {
-                            tabu_move_num++;
-                            if (randomInt(tabu_move_num) == 0) { best_tabu_move = move; }
-                        }
-                    }
-                } else {
-                    // 非禁忌移动
-                    if (move_delta1 < best_non_tabu_move_delta1) {
-                        // 一级评估函数更优，计算二级评估函数
-                        auto move_delta2          = evaluator_.evaluate_domain_delta(current_solution_, move);
-                        best_non_tabu_move_delta1 = move_delta1;
-                        best_non_tabu_move_delta2 = move_delta2;
-                        best_non_tabu_move        = move;
-                        non_tabu_move_num         = 1;
-                    } else if (move_delta1 == best_non_tabu_move_delta1) {
-                        // 一级评估函数相同，计算二级评估函数进行比较
-                        auto move_delta2 = evaluator_.evaluate_domain_delta(current_solution_, move);
-                        if (move_delta2 < best_non_tabu_move_delta2) {
-                            best_non_tabu_move_delta2 = move_delta2;
-                            best_non_tabu_move        = move;
-                            non_tabu_move_num         = 1;
-                        } else if (move_delta2 == best_non_tabu_move_delta2) {
-                            non_tabu_move_num++;
-                            if (randomInt(non_tabu_move_num) == 0) { best_non_tabu_move = move; }
-                        }
-                    }
-                }
-            }
+        for (auto i = 0; i < conflict_cols.size(); ++i) {
+            for (auto j = i + 1; j < conflict_cols.size(); ++j) { consider(Move{row, conflict_cols[i], conflict_cols[j]}); }
         }
-
         // 冲突节点 - 非冲突节点
-        for (const auto col1: row_conflict_grid_[row]) {
-            for (const auto col2: row_nonconflict_grid_[row]) {
-                Move move{row, col1, col2};
-
-                auto move_delta1 = evaluator_.evaluate_conflict_delta(current_solution_, move);
-
-                if (is_tabu(move, current_solution_.total_conflict + move_delta1)) {
-                    // 禁忌移动
-                    if (move_delta1 < best_tabu_move_delta1) {
-                        // 一级评估函数更优，计算二级评估函数
-                        auto move_delta2      = evaluator_.evaluate_domain_delta(current_solution_, move);
-                        best_tabu_move_delta1 = move_delta1;
-                        best_tabu_move_delta2 = move_delta2;
-                        best_tabu_move        = move;
-                        tabu_move_num         = 1;
-                    } else if (move_delta1 == best_tabu_move_delta1) {
-                        // 一级评估函数相同，计算二级评估函数进行比较
-                        auto move_delta2 = evaluator_.evaluate_domain_delta(current_solution_, move);
-                        if (move_delta2 < best_tabu_move_delta2) {
-                            best_tabu_move_delta2 = move_delta2;
-                            best_tabu_move        = move;
-                            tabu_move_num         = 1;
-                        } else if (move_delta2 == best_tabu_move_delta2) {
-                            tabu_move_num++;
-                            if (randomInt(tabu_move_num) == 0) { best_tabu_move = move; }
-                        }
-                    }
-                } else {
-                    // 非禁忌移动
-                    if (move_delta1 < best_non_tabu_move_delta1) {
-                        // 一级评估函数更优，计算二级评估函数
-                        auto move_delta2          = evaluator_.evaluate_domain_delta(current_solution_, move);
-                        best_non_tabu_move_delta1 = move_delta1;
-                        best_non_tabu_move_delta2 = move_delta2;
-                        best_non_tabu_move        = move;
-                        non_tabu_move_num         = 1;
-                    } else if (move_delta1 == best_non_tabu_move_delta1) {
-                        // 一级评估函数相同，计算二级评估函数进行比较
-                        auto move_delta2 = evaluator_.evaluate_domain_delta(current_solution_, move);
-                        if (move_delta2 < best_non_tabu_move_delta2) {
-                            best_non_tabu_move_delta2 = move_delta2;
-                            best_non_tabu_move        = move;
-                            non_tabu_move_num         = 1;
-                        } else if (move_delta2 == best_non_tabu_move_delta2) {
-                            non_tabu_move_num++;
-                            if (randomInt(non_tabu_move_num) == 0) { best_non_tabu_move = move; }
-                        }
-                    }
-                }
-            }
+        for (const auto col1: conflict_cols) {
+            for (const auto col2: nonconflict_cols) { consider(Move{row, col1, col2}); }
         }
     }
 
-    // 选择最佳移动：特赦规则 - 如果禁忌移动比历史最优解更好，则选择禁忌移动
-    if (current_solution_.total_conflict + best_tabu_move_delta1 < best_solution_.total_conflict &&
-        best_tabu_move_delta1 < best_non_tabu_move_delta1) {
-        return best_tabu_move;
-    }
+    if (aspirated()) { return best_tabu.move; }
 
     // 检查是否找到有效的移动
-    if (best_non_tabu_move.row_id == -1) {
+    if (best_non_tabu.move.row_id == -1) {
         throw std::runtime_error("No valid move found in find_move()");
     }
 
-    return best_non_tabu_move;
+    return best_non_tabu.move;
+}
+
+bool LocalSearch::sample_candidates_() {
+    const int N        = static_cast<int>(current_solution_.solution.size());
+    const auto samples = config_.candidates.sample_size;
+    candidate_cells_.clear();
+    candidate_weights_.clear();
+    candidate_sample_.clear();
+    if (samples <= 0) { return false; }
+    // 冲突格的权重为其 (颜色, 列) 上的格子数，同列同色越多越优先
+    int total_weight = 0;
+    for (auto row = 0; row < N; ++row) {
+        for (const auto col: row_grid_.conflict(row)) {
+            total_weight += evaluator_.color_count(current_solution_.solution[row][col], col);
+            candidate_cells_.emplace_back(row, col);
+            candidate_weights_.push_back(total_weight);
+        }
+    }
+    if (static_cast<int>(candidate_cells_.size()) <= samples) { return false; }
+
+    // 有放回地抽样，重复抽中的格子只保留一次
+    candidate_stamp_.resize(static_cast<size_t>(N) * N);
+    const auto stamp = iteration_ + 1;
+    for (auto draw = 0; draw < samples; ++draw) {
+        const auto index      = std::upper_bound(candidate_weights_.begin(), candidate_weights_.end(), randomInt(total_weight)) - candidate_weights_.begin();
+        const auto [row, col] = candidate_cells_[index];
+        auto &mark            = candidate_stamp_[static_cast<size_t>(row) * N + col];
+        if (mark == stamp) { continue; }
+        mark = stamp;
+        candidate_sample_.emplace_back(row, col);
+    }
+    return true;
 }
 
 void LocalSearch::make_move(const Move &move) {
@@ -225,75 +290,113 @@ void LocalSearch::make_move(const Move &move) {
     auto affected_cells = evaluator_.col_color_num_table_.make_move(current_solution_, move);
     current_solution_.total_conflict += move_delta1;
     current_solution_.domain_conflict += move_delta2;
+    current_solution_.hash ^= zobrist::swap_delta(move.row_id, move.col1, move.col2, current_solution_.get_color(move.row_id, move.col1),
+                                                  current_solution_.get_color(move.row_id, move.col2));
     std::swap(current_solution_.solution[move.row_id][move.col1], current_solution_.solution[move.row_id][move.col2]);
 
     // 增量更新冲突节点集合
-    update_row_conflict_grid_incremental_(affected_cells);
+    const auto &latin_square = evaluator_.latin_square();
+    row_grid_.update(latin_square, evaluator_, current_solution_, affected_cells);
 
     // 调试：验证冲突节点集合的正确性（可通过宏控制）
 #ifdef VERIFY_CONFLICT_GRID
-    verify_conflict_grid();
+    row_grid_.verify(latin_square, evaluator_, current_solution_);
 #endif
 }
 
-void LocalSearch::set_row_conflict_grid_(const Solution &solution) {
-    const int N = static_cast<int>(solution.solution.size());
-    row_conflict_grid_.clear();
-    row_conflict_grid_.resize(N, VecSet{N});
-    row_nonconflict_grid_.clear();
-    row_nonconflict_grid_.resize(N, VecSet{N});
-    for (auto row = 0; row < N; ++row) {
-        for (auto col = 0; col < N; ++col) {
-            if (evaluator_.color_in_domain_table_.latin_square_.is_fixed(row, col)) { continue; }
-            if (evaluator_.is_conflict_grid(solution.get_color(row, col), col)) {
-                row_conflict_grid_[row].insert(col);
-            } else {
-                row_nonconflict_grid_[row].insert(col);
-            }
-        }
-    }
+void LocalSearch::prepare_workspace_(const int N) {
+    if (!workspace_.needs_growth(N)) { return; }
+    // 出现了更大的规模：先归还所有从工作区分配的结构，再整体重置并扩容
+    tabu_list_.release();
+    evaluator_.release();
+    row_grid_.release();
+    workspace_.grow(N);
 }
 
-void LocalSearch::update_row_conflict_grid_incremental_(const std::vector<ColColorNumTable::AffectedCell> &affected_cells) {
-    // 收集所有受影响的列（去重）
-    std::vector<bool> affected_cols_set(current_solution_.solution.size(), false);
-    for (const auto &cell: affected_cells) {
-        affected_cols_set[cell.col] = true;
+void LocalSearch::reset_visited_() {
+    // 重访只供反应式禁忌期检测循环，关闭时不记录状态
+    const auto window = config_.tenure.reactive ? config_.tenure.revisit_window : 0;
+    if (visited_.window() != window) {
+        visited_.set_window(window);
+    } else {
+        visited_.clear();
     }
+}
 
-    const int N = static_cast<int>(current_solution_.solution.size());
-
-    // 对每个受影响的列，更新该列所有行的冲突状态
-    for (int col = 0; col < N; ++col) {
-        if (!affected_cols_set[col]) continue;
-
-        // 遍历该列的所有行
-        for (int row = 0; row < N; ++row) {
-            // 跳过固定的格子
-            if (evaluator_.color_in_domain_table_.latin_square_.is_fixed(row, col)) {
-                continue;
-            }
-
-            // 获取该格子的颜色
-            const auto color = current_solution_.get_color(row, col);
+bool LocalSearch::update_best_() {
+    if (!(current_solution_ <= best_solution_)) { return false; }
+    const bool improved = current_solution_.total_conflict < best_solution_.total_conflict;
+    best_solution_      = current_solution_;
+    if (improved) {
+        improved_since_restart_ = true;
+        ++telemetry_.improvements;
+        if (on_improvement_) { on_improvement_(best_solution_, iteration_); }
+    }
+    return improved;
+}
 
-            // 判断该格子是否冲突
-            const bool is_conflict = evaluator_.is_conflict_grid(color, col);
+void LocalSearch::perturb_(const LatinSquare &latin_square) {
+    if (!config_.perturbation.enabled) { return; }
+    const int strength      = perturbation_.adapt(improved_since_restart_);
+    improved_since_restart_ = false;
+    for (auto k = 0; k < strength; ++k) {
+        // 扰动幅度不超过重启阈值的一半，给后续下降留出余地，避免立即再次触发重启
+        if (current_solution_ - best_solution_ > rt / 2) { break; }
+        const auto move = perturbation_.propose(latin_square, current_solution_, row_grid_);
+        if (move.row_id < 0) { break; }
+        // 通过 make_move 增量更新记录表与冲突节点集合，并禁忌被移走的冲突颜色，防止立即撤销扰动
+        make_move(move);
+        ++telemetry_.perturbation_swaps;
+    }
+    update_best_();
+}
 
-            // 检查之前的状态
-            const bool was_in_conflict = row_conflict_grid_[row].contains(col);
+bool LocalSearch::relink_(const LatinSquare &latin_square) {
+    const auto &config = config_.relinking;
+    if (!config.enabled) { return false; }
+    // 历史最优解在同一冲突数下随搜索不断更新，每次重启时收集到的往往是不同的解
+    elites_.offer(best_solution_);
+    if (++restarts_since_relink_ < config.period) { return false; }
+    const auto pair = elites_.most_distant_pair();
+    if (!pair) { return false; }
+    restarts_since_relink_ = 0;
+    const auto &members    = elites_.members();
+    // 从较差的一端走向较好的一端
+    const auto &[initiating, guiding] = members[pair->first] < members[pair->second] ? std::tie(members[pair->second], members[pair->first])
+                                                                                      : std::tie(members[pair->first], members[pair->second]);
+    auto start = relinking_.relink(latin_square, evaluator_, initiating, guiding, config.min_steps);
+    // 中间解过差时会立即再次触发重启，此时退回扰动；记录表由调用方重建
+    if (!start || *start - best_solution_ >= rt) { return false; }
+    ++telemetry_.relinks;
+    current_solution_ = std::move(*start);
+    evaluator_.reset(latin_square, current_solution_);
+    row_grid_.rebuild(latin_square, evaluator_, current_solution_);
+    update_best_();
+    return true;
+}
 
-            if (is_conflict && !was_in_conflict) {
-                // 从非冲突变为冲突
-                row_nonconflict_grid_[row].erase(col);
-                row_conflict_grid_[row].insert(col);
-            } else if (!is_conflict && was_in_conflict) {
-                // 从冲突变为非冲突
-                row_conflict_grid_[row].erase(col);
-                row_nonconflict_grid_[row].insert(col);
-            }
-        }
-    }
+void LocalSearch::emit_checkpoint_(const LatinSquare &latin_square, const double elapsed_seconds) {
+    if (!on_checkpoint_) { return; }
+    const auto &instance             = *latin_square.instance_;
+    checkpoint_.n                      = instance.size();
+    checkpoint_.fixed_count            = static_cast<std::uint32_t>(instance.get_fixed().size());
+    checkpoint_.instance_fingerprint   = instance_fingerprint(instance);
+    checkpoint_.iteration              = iteration_;
+    checkpoint_.rt                     = rt;
+    checkpoint_.accu                   = accu;
+    checkpoint_.elapsed_seconds        = elapsed_offset_ + elapsed_seconds;
+    checkpoint_.perturbation_stagnation = perturbation_.stagnation();
+    checkpoint_.improved_since_restart = improved_since_restart_;
+    checkpoint_.tenure                 = tenure_.state();
+    visited_.export_generations(checkpoint_.visited_older, checkpoint_.visited_newer);
+    checkpoint_.restarts_since_relink  = restarts_since_relink_;
+    checkpoint_.elites                 = elites_.members();
+    checkpoint_.current                = current_solution_;
+    checkpoint_.best                   = best_solution_;
+    row_grid_.export_to(checkpoint_.row_conflict_grid, checkpoint_.row_nonconflict_grid);
+    tabu_list_.export_active(iteration_, checkpoint_.tabu);
+    checkpoint_.rng_state = qm::randomGenerator().saveState();
+    on_checkpoint_(checkpoint_);
 }
 
 bool LocalSearch::is_tabu(const Move &move, int conflict_num) const {
@@ -308,59 +411,18 @@ void LocalSearch::set_tabu(const Move &move) {
     const auto color1 = current_solution_.solution[move.row_id][move.col1];
     const auto color2 = current_solution_.solution[move.row_id][move.col2];
     // 禁忌当前的颜色
-    constexpr double alpha = 0.4;
+    const double alpha = tenure_.alpha();
     // 确保禁忌期至少为10，避免冲突数过小时禁忌期过短
     const auto base_tenure                     = static_cast<unsigned long long>(alpha * current_solution_.total_conflict);
     const auto target_iteration_without_random = base_tenure + iteration_;
+    const auto random_range                    = tenure_.random_range();
+    const auto random_tenure                   = [random_range] { return random_range > 0 ? randomInt(random_range) : 0; };
 
     // 只有当操作单元是冲突节点时，才将其加入禁忌表
     if (evaluator_.is_conflict_grid(color1, move.col1))
-        tabu_list_.make_tabu(move.row_id, move.col1, color1, target_iteration_without_random + randomInt(10));
+        tabu_list_.make_tabu(move.row_id, move.col1, color1, target_iteration_without_random + random_tenure());
     if (evaluator_.is_conflict_grid(color2, move.col2))
-        tabu_list_.make_tabu(move.row_id, move.col2, color2, target_iteration_without_random + randomInt(10));
+        tabu_list_.make_tabu(move.row_id, move.col2, color2, target_iteration_without_random + random_tenure());
 }
 
-void LocalSearch::verify_conflict_grid() const {
-    const int N = static_cast<int>(current_solution_.solution.size());
-
-    // 重新计算期望的冲突节点集合
-    std::vector<VecSet> expected_conflict(N, VecSet{N});
-    std::vector<VecSet> expected_nonconflict(N, VecSet{N});
-
-    for (auto row = 0; row < N; ++row) {
-        for (auto col = 0; col < N; ++col) {
-            if (evaluator_.color_in_domain_table_.latin_square_.is_fixed(row, col)) {
-                continue;
-            }
-            if (evaluator_.is_conflict_grid(current_solution_.get_color(row, col), col)) {
-                expected_conflict[row].insert(col);
-            } else {
-                expected_nonconflict[row].insert(col);
-            }
-        }
-    }
-
-    // 验证每一行
-    for (auto row = 0; row < N; ++row) {
-        if (row_conflict_grid_[row] != expected_conflict[row]) {
-            std::cerr << "Row " << row << " conflict grid mismatch!" << std::endl;
-            std::cerr << "Expected conflict: ";
-            for (auto col: expected_conflict[row]) {
-                std::cerr << col << " ";
-            }
-            std::cerr << std::endl;
-            std::cerr << "Actual conflict: ";
-            for (auto col: row_conflict_grid_[row]) {
-                std::cerr << col << " ";
-            }
-            std::cerr << std::endl;
-            throw std::runtime_error("Conflict grid verification failed");
-        }
-
-        if (row_nonconflict_grid_[row] != expected_nonconflict[row]) {
-            std::cerr << "Row " << row << " non-conflict grid mismatch!" << std::endl;
-            throw std::runtime_error("Non-conflict grid verification failed");
-        }
-    }
-}
 }// namespace qm::latin_square
\ No newline at end of file
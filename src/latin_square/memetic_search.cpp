@@ -0,0 +1,252 @@
+#include "latin_square/memetic_search.h"
+
+#include "latin_square/path_relinking.h"
+#include "utils/RandomGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace qm::latin_square {
+
+void MemeticSearch::search(const LatinSquare &latin_square, const Solution &solution, const unsigned long long max_iteration, const double time_limit_seconds) {
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    const auto elapsed    = [&start_time] { return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count(); };
+    // 改良的时间限制取剩余时间（不限时为 0）
+    const auto remaining     = [&] { return time_limit_seconds > 0 ? std::max(time_limit_seconds - elapsed(), 1e-9) : 0.0; };
+    const auto out_of_budget = [&] {
+        return stop_requested_() || iteration_ >= max_iteration || (time_limit_seconds > 0 && elapsed() >= time_limit_seconds) || best_solution_.total_conflict == 0;
+    };
+
+    const int threads = config_.threads > 0 ? config_.threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    prepare_workers_(threads);
+    iteration_     = 0;
+    best_solution_ = solution;
+    telemetry_.reset();
+
+    // 初始种群
+    population_.clear();
+    population_.push_back(solution);
+    for (auto i = 1; i < std::max(2, config_.population_size); ++i) { population_.push_back(diversify_(latin_square, solution)); }
+    improve_(latin_square, population_, remaining());
+    const auto population_size = population_.size();
+    distance_.assign(population_size, std::vector<int>(population_size, 0));
+    for (size_t i = 0; i < population_size; ++i) {
+        update_best_(population_[i]);
+        for (size_t j = 0; j < i; ++j) { distance_[i][j] = distance_[j][i] = hamming_distance(population_[i], population_[j]); }
+    }
+
+    std::vector<Solution> offspring;
+    unsigned long long generation = 0;
+    while (!out_of_budget()) {
+        // 每代产生与线程数相同的子代，并行改良
+        offspring.clear();
+        for (auto k = 0; k < threads; ++k) {
+            const int parent1 = select_parent_(-1);
+            const int parent2 = select_parent_(parent1);
+            offspring.push_back(crossover_(population_[parent1], population_[parent2]));
+        }
+        improve_(latin_square, offspring, remaining());
+        telemetry_.offspring += offspring.size();
+        for (auto &child: offspring) {
+            update_best_(child);
+            if (update_population_(std::move(child))) { ++telemetry_.offspring_accepted; }
+        }
+        ++generation;
+        if (config_.verbose) {
+            int worst = 0;
+            for (const auto &member: population_) { worst = std::max(worst, member.total_conflict); }
+            std::clog << "第 " << generation << " 代: 最优冲突数 " << best_solution_.total_conflict << "，种群最差 " << worst << "，累计迭代 " << iteration_ << std::endl;
+        }
+    }
+
+    if (config_.verbose) {
+        std::clog << "模因搜索结束，总时间: " << std::fixed << std::setprecision(3) << elapsed() << " s，共 " << generation << " 代" << std::endl;
+        std::clog << "最终冲突数: " << best_solution_.total_conflict << std::endl;
+        std::clog << "遥测: " << telemetry_ << std::endl;
+    }
+}
+
+void MemeticSearch::prepare_workers_(const int threads) {
+    auto search_config    = config_.search;
+    search_config.verbose = false;
+    while (workers_.size() < static_cast<size_t>(threads)) { workers_.push_back(std::make_unique<LocalSearch>()); }
+    for (auto &worker: workers_) {
+        worker->set_config(search_config);
+        worker->set_stop_flag(stop_flag_);
+    }
+}
+
+void MemeticSearch::improve_(const LatinSquare &latin_square, std::vector<Solution> &batch, const double time_limit_seconds) {
+    // 种子在主线程中按顺序生成，保证结果不依赖线程调度
+    std::vector<unsigned> seeds(batch.size());
+    for (auto &seed: seeds) { seed = static_cast<unsigned>(randomInt(std::numeric_limits<int>::max())); }
+
+    const auto threads = std::min(workers_.size(), batch.size());
+    std::vector<unsigned long long> iterations(threads, 0);
+    std::vector<std::exception_ptr> errors(threads);
+    const auto run = [&](const size_t worker_index) {
+        try {
+            auto &worker = *workers_[worker_index];
+            for (auto i = worker_index; i < batch.size(); i += threads) {
+                if (batch[i].total_conflict == 0) { continue; }
+                setRandomSeed(seeds[i]);
+                worker.search(latin_square, batch[i], config_.improvement_iterations, time_limit_seconds);
+                iterations[worker_index] += worker.iteration();
+                batch[i] = worker.best_solution();
+            }
+        } catch (...) { errors[worker_index] = std::current_exception(); }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (size_t t = 1; t < threads; ++t) { pool.emplace_back(run, t); }
+    // 主线程自己承担第 0 份工作；主线程的随机数状态在改良后恢复
+    const auto main_state = randomGenerator().saveState();
+    run(0);
+    randomGenerator().restoreState(main_state);
+    for (auto &thread: pool) { thread.join(); }
+
+    for (const auto &error: errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+    for (const auto count: iterations) { iteration_ += count; }
+}
+
+Solution MemeticSearch::diversify_(const LatinSquare &latin_square, const Solution &solution) const {
+    auto grid   = solution.solution;
+    const int N = static_cast<int>(grid.size());
+    for (auto row = 0; row < N; ++row) {
+        const auto free_cols = latin_square.free_cols(row);
+        const int count = static_cast<int>(free_cols.size());
+        if (count < 2) { continue; }
+        // 每行尝试 count / 2 次交换，只保留交换后两格颜色都在颜色域内的交换
+        for (auto k = 0; k < count / 2; ++k) {
+            const int col1 = free_cols[randomInt(count)];
+            const int col2 = free_cols[randomInt(count)];
+            if (col1 == col2 || !latin_square.color_in_domain(row, col1, grid[row][col2]) || !latin_square.color_in_domain(row, col2, grid[row][col1])) { continue; }
+            std::swap(grid[row][col1], grid[row][col2]);
+        }
+    }
+    return Solution{std::move(grid)};
+}
+
+Solution MemeticSearch::crossover_(const Solution &parent1, const Solution &parent2) const {
+    const int N = static_cast<int>(parent1.solution.size());
+    // 每个父代各行的冲突格数（该格颜色在所在列中不止出现一次）
+    const auto row_conflicts = [N](const Solution &parent) {
+        std::vector<int> count(static_cast<size_t>(N) * N, 0);
+        for (const auto &row: parent.solution) {
+            for (auto col = 0; col < N; ++col) { ++count[row[col] * N + col]; }
+        }
+        std::vector<int> conflicts(N, 0);
+        for (auto row = 0; row < N; ++row) {
+            for (auto col = 0; col < N; ++col) { conflicts[row] += count[parent.solution[row][col] * N + col] > 1 ? 1 : 0; }
+        }
+        return conflicts;
+    };
+    const auto conflicts1 = row_conflicts(parent1);
+    const auto conflicts2 = row_conflicts(parent2);
+
+    std::vector<std::vector<int>> grid(N);
+    int from_first = 0;
+    for (auto row = 0; row < N; ++row) {
+        // 以 greedy_rows 的概率取本行冲突较少的父代（相同时随机），否则随机取
+        bool first = randomInt(2) == 0;
+        if (conflicts1[row] != conflicts2[row] && randomDouble(0.0, 1.0) < config_.greedy_rows) { first = conflicts1[row] < conflicts2[row]; }
+        grid[row] = first ? parent1.solution[row] : parent2.solution[row];
+        from_first += first ? 1 : 0;
+    }
+    // 保证两个父代都有贡献
+    if (N >= 2 && (from_first == 0 || from_first == N)) {
+        const int row = randomInt(N);
+        grid[row]     = from_first == 0 ? parent1.solution[row] : parent2.solution[row];
+    }
+    return Solution{std::move(grid)};
+}
+
+int MemeticSearch::select_parent_(const int excluded) const {
+    // 二元锦标赛：随机取两个个体，选冲突数较少者
+    const int size  = static_cast<int>(population_.size());
+    const auto pick = [&] {
+        int index = randomInt(size);
+        if (index == excluded) { index = (index + 1 + randomInt(size - 1)) % size; }
+        return index;
+    };
+    const int a = pick();
+    const int b = pick();
+    return population_[a].total_conflict <= population_[b].total_conflict ? a : b;
+}
+
+bool MemeticSearch::update_population_(Solution &&offspring) {
+    const auto size = population_.size();
+    std::vector<int> offspring_distance(size);
+    for (size_t i = 0; i < size; ++i) {
+        // 哈希相同视为重复个体（改良后常收敛回同一个局部最优）
+        if (population_[i].hash == offspring.hash) { return false; }
+        offspring_distance[i] = hamming_distance(population_[i], offspring);
+    }
+
+    // 候选集合 = 种群 + 子代（下标 size），计算每个候选到其它候选的最小距离
+    const auto distance = [&](const size_t i, const size_t j) {
+        if (i == size) { return offspring_distance[j]; }
+        if (j == size) { return offspring_distance[i]; }
+        return distance_[i][j];
+    };
+    const auto conflict = [&](const size_t i) { return i == size ? offspring.total_conflict : population_[i].total_conflict; };
+    std::vector<int> min_distance(size + 1, std::numeric_limits<int>::max());
+    for (size_t i = 0; i <= size; ++i) {
+        for (size_t j = 0; j <= size; ++j) {
+            if (i != j) { min_distance[i] = std::min(min_distance[i], distance(i, j)); }
+        }
+    }
+    const auto [min_conflict, max_conflict] = [&] {
+        int lo = std::numeric_limits<int>::max(), hi = 0;
+        for (size_t i = 0; i <= size; ++i) {
+            lo = std::min(lo, conflict(i));
+            hi = std::max(hi, conflict(i));
+        }
+        return std::pair{lo, hi};
+    }();
+    const auto [min_dist, max_dist] = std::ranges::minmax(min_distance);
+
+    // 得分越高越差：冲突数越多、与其它个体越相近越差
+    size_t worst       = size;
+    double worst_score = -1;
+    for (size_t i = 0; i <= size; ++i) {
+        const double quality = static_cast<double>(conflict(i) - min_conflict) / (max_conflict - min_conflict + 1);
+        const double spread  = static_cast<double>(min_distance[i] - min_dist) / (max_dist - min_dist + 1);
+        const double score   = config_.quality_weight * quality + (1 - config_.quality_weight) * (1 - spread);
+        if (score > worst_score) {
+            worst_score = score;
+            worst       = i;
+        }
+    }
+    if (worst == size) { return false; }
+
+    population_[worst] = std::move(offspring);
+    for (size_t j = 0; j < size; ++j) {
+        if (j != worst) { distance_[worst][j] = distance_[j][worst] = offspring_distance[j]; }
+    }
+    distance_[worst][worst] = 0;
+    return true;
+}
+
+bool MemeticSearch::update_best_(const Solution &solution) {
+    if (!(solution < best_solution_)) { return false; }
+    const bool improved = solution.total_conflict < best_solution_.total_conflict;
+    best_solution_      = solution;
+    if (improved) {
+        ++telemetry_.improvements;
+        if (on_improvement_) { on_improvement_(best_solution_, iteration_); }
+    }
+    return improved;
+}
+
+bool MemeticSearch::stop_requested_() const { return stop_flag_ != nullptr && stop_flag_->load(std::memory_order_relaxed); }
+
+}// namespace qm::latin_square
@@ -0,0 +1,170 @@
+#include "latin_square/path_relinking.h"
+
+#include "latin_square/zobrist.h"
+#include "utils/RandomGenerator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace qm::latin_square {
+
+namespace {
+// 一行中颜色不同的格子数
+int row_distance(const int *a, const int *b, const int n) {
+    int distance = 0;
+    int col      = 0;
+#if defined(__AVX2__)
+    for (; col + 8 <= n; col += 8) {
+        const auto va    = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + col));
+        const auto vb    = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + col));
+        const auto equal = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(va, vb))));
+        distance += 8 - __builtin_popcount(equal);
+    }
+#elif defined(__SSE2__)
+    for (; col + 4 <= n; col += 4) {
+        const auto va    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + col));
+        const auto vb    = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + col));
+        const auto equal = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(va, vb))));
+        distance += 4 - __builtin_popcount(equal);
+    }
+#endif
+    for (; col < n; ++col) { distance += a[col] != b[col] ? 1 : 0; }
+    return distance;
+}
+}// namespace
+
+int hamming_distance(const Solution &a, const Solution &b) {
+    int distance = 0;
+    for (size_t row = 0; row < a.solution.size(); ++row) {
+        distance += row_distance(a.solution[row].data(), b.solution[row].data(), static_cast<int>(a.solution[row].size()));
+    }
+    return distance;
+}
+
+void ElitePool::set_capacity(const int capacity) {
+    capacity_ = std::max(capacity, 0);
+    if (members_.size() > static_cast<size_t>(capacity_)) { members_.resize(capacity_); }
+}
+
+bool ElitePool::offer(const Solution &solution) {
+    if (capacity_ == 0) { return false; }
+    for (const auto &member: members_) {
+        if (member.hash == solution.hash) { return false; }
+    }
+    if (members_.size() < static_cast<size_t>(capacity_)) {
+        members_.push_back(solution);
+        return true;
+    }
+    // 池满：替换冲突数最多的成员，相同时替换与新解最相近的成员
+    size_t victim   = 0;
+    int victim_dist = std::numeric_limits<int>::max();
+    for (size_t i = 0; i < members_.size(); ++i) {
+        if (members_[i].total_conflict < members_[victim].total_conflict) { continue; }
+        const int distance = hamming_distance(members_[i], solution);
+        if (members_[i].total_conflict > members_[victim].total_conflict || distance < victim_dist) {
+            victim      = i;
+            victim_dist = distance;
+        }
+    }
+    if (solution.total_conflict > members_[victim].total_conflict) { return false; }
+    members_[victim] = solution;
+    return true;
+}
+
+std::optional<std::pair<int, int>> ElitePool::most_distant_pair() const {
+    std::optional<std::pair<int, int>> pair;
+    int best = -1;
+    for (auto i = 0; i < size(); ++i) {
+        for (auto j = i + 1; j < size(); ++j) {
+            const int distance = hamming_distance(members_[i], members_[j]);
+            if (distance > best) {
+                best = distance;
+                pair = std::pair{i, j};
+            }
+        }
+    }
+    return pair;
+}
+
+std::optional<Solution> PathRelinking::relink(const LatinSquare &latin_square, Evaluator &evaluator, const Solution &initiating, const Solution &guiding, int min_steps) {
+    const int N      = static_cast<int>(initiating.solution.size());
+    Solution current = initiating;
+    evaluator.reset(latin_square, current);
+
+    // 行内交换只能在排列之间移动，两端的每一行都必须是排列
+    position_.assign(N, std::vector<int>(N, -1));
+    for (auto row = 0; row < N; ++row) {
+        for (auto col = 0; col < N; ++col) {
+            auto &position = position_[row][current.solution[row][col]];
+            if (position >= 0) { return std::nullopt; }
+            position = col;
+        }
+    }
+    differing_.clear();
+    slot_.assign(static_cast<size_t>(N) * N, -1);
+    for (auto row = 0; row < N; ++row) {
+        for (auto col = 0; col < N; ++col) {
+            if (current.solution[row][col] == guiding.solution[row][col]) { continue; }
+            slot_[row * N + col] = static_cast<int>(differing_.size());
+            differing_.push_back(row * N + col);
+        }
+    }
+    const auto settle = [this, &current, &guiding, N](const int row, const int col) {
+        const int cell = row * N + col;
+        if (slot_[cell] < 0 || current.solution[row][col] != guiding.solution[row][col]) { return; }
+        const int last          = differing_.back();
+        differing_[slot_[cell]] = last;
+        slot_[last]             = slot_[cell];
+        differing_.pop_back();
+        slot_[cell] = -1;
+    };
+
+    // 每步至少让一个格子与引导解一致，总步数不超过距离
+    min_steps = std::max(min_steps, 1);
+    std::optional<Solution> best;
+    for (auto step = 1; !differing_.empty(); ++step) {
+        Move best_move{-1, -1, -1};
+        int best_delta1 = std::numeric_limits<int>::max();
+        int best_delta2 = std::numeric_limits<int>::max();
+        int ties        = 0;
+        for (const auto cell: differing_) {
+            const int row = cell / N;
+            const int col = cell % N;
+            const Move move{row, col, position_[row][guiding.solution[row][col]]};
+            const int delta1 = evaluator.evaluate_conflict_delta(current, move);
+            if (delta1 > best_delta1) { continue; }
+            const int delta2 = evaluator.evaluate_domain_delta(current, move);
+            if (delta1 < best_delta1 || delta2 < best_delta2) {
+                best_move   = move;
+                best_delta1 = delta1;
+                best_delta2 = delta2;
+                ties        = 1;
+            } else if (delta2 == best_delta2 && randomInt(++ties) == 0) {
+                best_move = move;
+            }
+        }
+
+        const int color1 = current.get_color(best_move.row_id, best_move.col1);
+        const int color2 = current.get_color(best_move.row_id, best_move.col2);
+        evaluator.update(current, best_move);
+        current.total_conflict += best_delta1;
+        current.domain_conflict += best_delta2;
+        current.hash ^= zobrist::swap_delta(best_move.row_id, best_move.col1, best_move.col2, color1, color2);
+        std::swap(current.solution[best_move.row_id][best_move.col1], current.solution[best_move.row_id][best_move.col2]);
+        position_[best_move.row_id][color1] = best_move.col2;
+        position_[best_move.row_id][color2] = best_move.col1;
+        settle(best_move.row_id, best_move.col1);
+        settle(best_move.row_id, best_move.col2);
+
+        // 只取离两端都足够远的中间解，太近的中间解会让搜索落回原来的盆地
+        if (step >= min_steps && static_cast<int>(differing_.size()) >= min_steps && (!best || current < *best)) { best = current; }
+    }
+    return best;
+}
+
+}// namespace qm::latin_square
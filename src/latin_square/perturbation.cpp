@@ -0,0 +1,53 @@
+#include "latin_square/perturbation.h"
+
+#include "utils/RandomGenerator.h"
+
+#include <algorithm>
+
+namespace qm::latin_square {
+
+int Perturbation::strength() const {
+    const int growth = stagnation_ / std::max(1, config_.growth_period);
+    return std::max(0, std::min(config_.min_strength + growth, config_.max_strength));
+}
+
+int Perturbation::adapt(const bool improved_since_last_restart) {
+    stagnation_ = improved_since_last_restart ? 0 : stagnation_ + 1;
+    return strength();
+}
+
+Move Perturbation::propose(const LatinSquare &latin_square, const Solution &solution, const RowConflictGrid &grid) {
+    const int N = static_cast<int>(solution.solution.size());
+    // 行内非固定格按 [冲突节点..., 非冲突节点...] 统一编号
+    const auto free_col = [&](const int row, const int index) {
+        const auto conflicts = grid.conflict(row).size();
+        return index < conflicts ? grid.conflict(row)[index] : grid.nonconflict(row)[index - conflicts];
+    };
+
+    bool directed = randomDouble(0.0, 1.0) < config_.conflict_directed;
+    if (directed) {
+        conflict_rows_.clear();
+        for (auto row = 0; row < N; ++row) {
+            if (!grid.conflict(row).empty() && grid.free_count(row) >= 2) { conflict_rows_.push_back(row); }
+        }
+        directed = !conflict_rows_.empty();
+    }
+
+    Move candidate{-1, -1, -1};
+    for (auto attempt = 0; attempt < std::max(1, config_.domain_attempts); ++attempt) {
+        const int row = directed ? conflict_rows_[randomInt(static_cast<int>(conflict_rows_.size()))] : randomInt(N);
+        const int count = grid.free_count(row);
+        if (count < 2) { continue; }
+        const int col1 = directed ? grid.conflict(row)[randomInt(grid.conflict(row).size())] : free_col(row, randomInt(count));
+        const int col2 = free_col(row, randomInt(count));
+        if (col1 == col2) { continue; }
+        candidate = Move{row, col1, col2};
+        // 交换后两格颜色都在颜色域内则直接采用，否则继续尝试，最终退回最后一个候选
+        if (latin_square.color_in_domain(row, col1, solution.get_color(row, col2)) && latin_square.color_in_domain(row, col2, solution.get_color(row, col1))) {
+            return candidate;
+        }
+    }
+    return candidate;
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,77 @@
+#include "latin_square/portfolio_search.h"
+
+#include "utils/RandomGenerator.h"
+
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace qm::latin_square {
+
+namespace {
+constexpr auto POLL_INTERVAL = std::chrono::milliseconds(2);// 主线程转发外部停止标志的轮询间隔
+}// namespace
+
+void PortfolioSearch::search(const LatinSquare &latin_square, const Solution &solution, const unsigned long long max_iteration, const double time_limit_seconds) {
+    if (members_.empty()) { throw std::logic_error("PortfolioSearch has no members"); }
+    finished_.store(false, std::memory_order_relaxed);
+    reported_conflict_ = solution.total_conflict;
+    best_solution_     = solution;
+    iteration_         = 0;
+    telemetry_.reset();
+    winner_.clear();
+
+    // 种子在主线程中按顺序生成，每个成员的轨迹只取决于它自己的种子
+    std::vector<unsigned> seeds(members_.size());
+    for (auto &seed: seeds) { seed = static_cast<unsigned>(randomInt(std::numeric_limits<int>::max())); }
+
+    for (auto &member: members_) {
+        member->set_stop_flag(&finished_);
+        member->set_improvement_callback([this](const Solution &best, const unsigned long long iteration) {
+            const std::lock_guard lock(improvement_mutex_);
+            if (best.total_conflict >= reported_conflict_) { return; }
+            reported_conflict_ = best.total_conflict;
+            if (on_improvement_) { on_improvement_(best, iteration); }
+        });
+    }
+
+    std::atomic<size_t> running{members_.size()};
+    std::vector<std::exception_ptr> errors(members_.size());
+    std::vector<std::thread> threads;
+    threads.reserve(members_.size());
+    for (size_t i = 0; i < members_.size(); ++i) {
+        threads.emplace_back([&, i] {
+            try {
+                setRandomSeed(seeds[i]);
+                members_[i]->search(latin_square, solution, max_iteration, time_limit_seconds);
+                if (members_[i]->best_solution().total_conflict == 0) { finished_.store(true, std::memory_order_relaxed); }
+            } catch (...) {
+                errors[i] = std::current_exception();
+                finished_.store(true, std::memory_order_relaxed);
+            }
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    // 成员只看组合自己的停止标志，外部停止请求由主线程转发
+    while (running.load(std::memory_order_acquire) > 0) {
+        if (stop_flag_ != nullptr && stop_flag_->load(std::memory_order_relaxed)) { finished_.store(true, std::memory_order_relaxed); }
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+    for (auto &thread: threads) { thread.join(); }
+
+    for (const auto &error: errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+    const SearchEngine *best = nullptr;
+    for (const auto &member: members_) {
+        iteration_ += member->iteration();
+        if (best == nullptr || member->best_solution() < best->best_solution()) { best = member.get(); }
+    }
+    best_solution_ = best->best_solution();
+    telemetry_     = best->telemetry();
+    winner_        = best->name();
+}
+
+}// namespace qm::latin_square
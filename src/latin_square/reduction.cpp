@@ -0,0 +1,79 @@
+#include "latin_square/reduction.h"
+
+namespace qm::latin_square {
+
+std::optional<Reduction> Reduction::analyze(const LatinSquare &latin_square) {
+    const int N = latin_square.get_instance_size();
+    std::vector<int> fixed_rows;
+    std::vector<int> fixed_cols;
+    Reduction reduction;
+    for (auto index = 0; index < N; ++index) {
+        (latin_square.free_cols(index).empty() ? fixed_rows : reduction.rows_).push_back(index);
+        (latin_square.free_rows(index).empty() ? fixed_cols : reduction.cols_).push_back(index);
+    }
+    const auto k = static_cast<int>(fixed_rows.size());
+    if (k == 0 || k == N || static_cast<int>(fixed_cols.size()) != k) { return std::nullopt; }
+
+    const auto &domain = latin_square.color_domain_;
+    // 颜色域为空的格子说明实例无解，留给完整搜索处理
+    for (auto row = 0; row < N; ++row) {
+        for (auto col = 0; col < N; ++col) {
+            if (domain(row, col).size == 0) { return std::nullopt; }
+        }
+    }
+
+    // 以第一个剩余行在固定列上的颜色作为 S，其余剩余行与剩余列必须与之相同
+    std::vector<bool> in_s(N, false);
+    for (const auto col: fixed_cols) { in_s[domain(reduction.rows_.front(), col).get_first_element()] = true; }
+    const auto same_set = [&](const auto &color_at) {
+        std::vector<bool> seen(N, false);
+        for (auto index = 0; index < k; ++index) {
+            const int color = color_at(index);
+            if (!in_s[color] || seen[color]) { return false; }
+            seen[color] = true;
+        }
+        return true;
+    };
+    for (const auto row: reduction.rows_) {
+        if (!same_set([&](const int index) { return domain(row, fixed_cols[index]).get_first_element(); })) { return std::nullopt; }
+    }
+    for (const auto col: reduction.cols_) {
+        if (!same_set([&](const int index) { return domain(fixed_rows[index], col).get_first_element(); })) { return std::nullopt; }
+    }
+
+    std::vector<int> reduced_color(N, -1);
+    for (auto color = 0; color < N; ++color) {
+        if (in_s[color]) { continue; }
+        reduced_color[color] = static_cast<int>(reduction.colors_.size());
+        reduction.colors_.push_back(color);
+    }
+
+    reduction.grid_.assign(N, std::vector<int>(N, -1));
+    for (auto row = 0; row < N; ++row) {
+        for (auto col = 0; col < N; ++col) {
+            if (latin_square.is_fixed(row, col)) { reduction.grid_[row][col] = domain(row, col).get_first_element(); }
+        }
+    }
+    // 剩余子方阵中的固定格成为子实例的预填格；其颜色必然不在 S 中，否则与同行的固定列重复
+    std::vector<Assignment> fixed;
+    for (auto i = 0; i < N - k; ++i) {
+        for (auto j = 0; j < N - k; ++j) {
+            const int color = reduction.grid_[reduction.rows_[i]][reduction.cols_[j]];
+            if (color == -1) { continue; }
+            if (reduced_color[color] == -1) { return std::nullopt; }
+            fixed.emplace_back(i, j, reduced_color[color]);
+        }
+    }
+    reduction.instance_ = std::make_shared<Instance>(N - k, std::move(fixed));
+    return reduction;
+}
+
+Solution Reduction::lift(const Solution &reduced) const {
+    auto grid = grid_;
+    for (size_t i = 0; i < rows_.size(); ++i) {
+        for (size_t j = 0; j < cols_.size(); ++j) { grid[rows_[i]][cols_[j]] = colors_[reduced.solution[i][j]]; }
+    }
+    return Solution{std::move(grid)};
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,120 @@
+#include "latin_square/row_conflict_grid.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace qm::latin_square {
+
+void RowConflictGrid::rebuild(const LatinSquare &latin_square, const Evaluator &evaluator, const Solution &solution) {
+    const int N = static_cast<int>(solution.solution.size());
+    VecSet::reset_all(conflict_, N, N);
+    VecSet::reset_all(nonconflict_, N, N);
+    for (auto row = 0; row < N; ++row) {
+        for (const auto col: latin_square.free_cols(row)) {
+            if (evaluator.is_conflict_grid(solution.get_color(row, col), col)) {
+                conflict_[row].insert(col);
+            } else {
+                nonconflict_[row].insert(col);
+            }
+        }
+    }
+}
+
+void RowConflictGrid::update(const LatinSquare &latin_square, const Evaluator &evaluator, const Solution &solution,
+                             const ColColorNumTable::AffectedCells &affected_cells) {
+    // 受影响的列只有交换的两列，按列号升序更新以保持集合内元素顺序
+    const auto [first_col, second_col] = std::minmax(affected_cells[0].col, affected_cells[1].col);
+    for (const int col: {first_col, second_col}) {
+        // 遍历该列的非固定格
+        for (const auto row: latin_square.free_rows(col)) {
+            // 判断该格子是否冲突，并与之前的状态比较
+            const bool is_conflict     = evaluator.is_conflict_grid(solution.get_color(row, col), col);
+            const bool was_in_conflict = conflict_[row].contains(col);
+
+            if (is_conflict && !was_in_conflict) {
+                // 从非冲突变为冲突
+                nonconflict_[row].erase(col);
+                conflict_[row].insert(col);
+            } else if (!is_conflict && was_in_conflict) {
+                // 从冲突变为非冲突
+                conflict_[row].erase(col);
+                nonconflict_[row].insert(col);
+            }
+        }
+    }
+}
+
+void RowConflictGrid::restore(const LatinSquare &latin_square, const Evaluator &evaluator, const Solution &solution, const std::vector<std::vector<int>> &conflict,
+                              const std::vector<std::vector<int>> &nonconflict) {
+    const int N = static_cast<int>(solution.solution.size());
+    if (conflict.size() != static_cast<size_t>(N) || nonconflict.size() != static_cast<size_t>(N)) {
+        throw std::runtime_error("检查点中的冲突节点集合行数与规模不符");
+    }
+    VecSet::reset_all(conflict_, N, N);
+    VecSet::reset_all(nonconflict_, N, N);
+    int restored = 0;
+    for (auto row = 0; row < N; ++row) {
+        for (const bool is_conflict: {true, false}) {
+            auto &grid       = is_conflict ? conflict_[row] : nonconflict_[row];
+            const auto &cols = is_conflict ? conflict[row] : nonconflict[row];
+            for (const auto col: cols) {
+                // 校验：非固定格、状态与当前解一致、不重复出现
+                if (col < 0 || col >= N || latin_square.is_fixed(row, col) || evaluator.is_conflict_grid(solution.get_color(row, col), col) != is_conflict
+                    || conflict_[row].contains(col) || !grid.insert(col)) {
+                    throw std::runtime_error("检查点中的冲突节点集合与当前解不一致");
+                }
+                ++restored;
+            }
+        }
+    }
+    if (restored != latin_square.free_cell_count()) { throw std::runtime_error("检查点中的冲突节点集合不完整"); }
+}
+
+void RowConflictGrid::export_to(std::vector<std::vector<int>> &conflict, std::vector<std::vector<int>> &nonconflict) const {
+    const auto copy_grid = [](const std::pmr::vector<VecSet> &grid, std::vector<std::vector<int>> &out) {
+        out.resize(grid.size());
+        for (size_t row = 0; row < grid.size(); ++row) { out[row].assign(grid[row].begin(), grid[row].end()); }
+    };
+    copy_grid(conflict_, conflict);
+    copy_grid(nonconflict_, nonconflict);
+}
+
+void RowConflictGrid::verify(const LatinSquare &latin_square, const Evaluator &evaluator, const Solution &solution) const {
+    const int N = static_cast<int>(solution.solution.size());
+
+    // 重新计算期望的冲突节点集合
+    std::vector<VecSet> expected_conflict(N, VecSet{N});
+    std::vector<VecSet> expected_nonconflict(N, VecSet{N});
+
+    for (auto row = 0; row < N; ++row) {
+        for (const auto col: latin_square.free_cols(row)) {
+            if (evaluator.is_conflict_grid(solution.get_color(row, col), col)) {
+                expected_conflict[row].insert(col);
+            } else {
+                expected_nonconflict[row].insert(col);
+            }
+        }
+    }
+
+    // 验证每一行
+    for (auto row = 0; row < N; ++row) {
+        if (conflict_[row] != expected_conflict[row]) {
+            std::cerr << "Row " << row << " conflict grid mismatch!" << std::endl;
+            std::cerr << "Expected conflict: ";
+            for (auto col: expected_conflict[row]) { std::cerr << col << " "; }
+            std::cerr << std::endl;
+            std::cerr << "Actual conflict: ";
+            for (auto col: conflict_[row]) { std::cerr << col << " "; }
+            std::cerr << std::endl;
+            throw std::runtime_error("Conflict grid verification failed");
+        }
+
+        if (nonconflict_[row] != expected_nonconflict[row]) {
+            std::cerr << "Row " << row << " non-conflict grid mismatch!" << std::endl;
+            throw std::runtime_error("Non-conflict grid verification failed");
+        }
+    }
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,68 @@
+#include "latin_square/search_workspace.h"
+
+#include "latin_square/vec_set.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace qm::latin_square {
+
+namespace {
+constexpr std::size_t ALLOCATION_OVERHEAD = 2 * alignof(std::max_align_t);// 每次分配的对齐损耗上界
+
+std::size_t vec_set_bytes(std::size_t universe) {
+    return sizeof(VecSet) + universe * sizeof(int) + std::min<std::size_t>(universe, 64) * sizeof(int) + 2 * ALLOCATION_OVERHEAD;
+}
+}// namespace
+
+void *Arena::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+    const auto aligned = (offset_ + alignment - 1) / alignment * alignment;
+    if (block_ && aligned + bytes <= capacity_) {
+        offset_     = aligned + bytes;
+        high_water_ = std::max(high_water_, used());
+        return block_.get() + aligned;
+    }
+    // 主块不足：回退到上游，并记录需求以便下次 reset 时扩容
+    void *ptr = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    overflow_.push_back({ptr, bytes, alignment});
+    overflow_bytes_ += bytes + alignment;
+    high_water_ = std::max(high_water_, used());
+    return ptr;
+}
+
+void Arena::release_overflow() {
+    for (const auto &block: overflow_) { std::pmr::new_delete_resource()->deallocate(block.ptr, block.bytes, block.alignment); }
+    overflow_.clear();
+    overflow_bytes_ = 0;
+}
+
+void Arena::reset() {
+    release_overflow();
+    offset_ = 0;
+    if (high_water_ > capacity_) { reserve(high_water_); }
+}
+
+void Arena::reserve(const std::size_t capacity) {
+    if (capacity <= capacity_) { return; }
+    block_    = std::make_unique<std::byte[]>(capacity);
+    capacity_ = capacity;
+    offset_   = 0;
+}
+
+void SearchWorkspace::grow(const int n) {
+    arena_.reset();
+    arena_.reserve(estimate_bytes(n));
+    largest_order_ = std::max(largest_order_, n);
+}
+
+std::size_t SearchWorkspace::estimate_bytes(const int n) {
+    const auto N = static_cast<std::size_t>(std::max(n, 0));
+    std::size_t bytes = 0;
+    bytes += N * N * N * sizeof(std::uint32_t) + ALLOCATION_OVERHEAD;// 禁忌表
+    bytes += N * N * vec_set_bytes(N) + ALLOCATION_OVERHEAD;                // (颜色, 列) 记录表
+    bytes += 2 * (N * vec_set_bytes(N) + ALLOCATION_OVERHEAD);              // 行冲突 / 非冲突节点集合
+    bytes += N * N + ALLOCATION_OVERHEAD;                                   // 颜色域冲突表
+    return bytes + 4096;
+}
+
+}// namespace qm::latin_square
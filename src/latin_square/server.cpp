@@ -0,0 +1,351 @@
+#include "latin_square/server.h"
+
+#include "latin_square/binary_io.h"
+#include "latin_square/color_domain.h"
+#include "latin_square/solver.h"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define QM_HAS_UNIX_SOCKET 1
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace qm::latin_square {
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr std::size_t REQUEST_HEADER_SIZE  = 16;// request_id + deadline_ms + seed
+constexpr std::size_t RESPONSE_HEADER_SIZE = 32;// request_id + status + conflicts + iterations + elapsed
+
+template<typename T>
+void append_le(binary::Bytes &out, T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) { out.push_back(static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8 * i))); }
+}
+
+template<typename T>
+T load_le(const std::uint8_t *p) {
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) { value |= static_cast<std::uint64_t>(p[i]) << (8 * i); }
+    return static_cast<T>(value);
+}
+
+#ifdef QM_HAS_UNIX_SOCKET
+// 读满 size 字节；对端在帧起始处关闭返回 false，帧中途关闭抛出异常
+bool read_full(int fd, std::uint8_t *data, std::size_t size) {
+    std::size_t done = 0;
+    while (done < size) {
+        const auto n = ::read(fd, data + done, size - done);
+        if (n > 0) {
+            done += static_cast<std::size_t>(n);
+        } else if (n == 0) {
+            if (done == 0) { return false; }
+            throw std::runtime_error("Connection closed in the middle of a frame");
+        } else if (errno != EINTR) {
+            throw std::runtime_error(std::string("read failed: ") + std::strerror(errno));
+        }
+    }
+    return true;
+}
+
+// 套接字使用 send(MSG_NOSIGNAL)，避免对端关闭时进程收到 SIGPIPE
+bool write_full(int fd, const std::uint8_t *data, std::size_t size, bool is_socket) {
+    std::size_t done = 0;
+    while (done < size) {
+#ifdef MSG_NOSIGNAL
+        const auto n = is_socket ? ::send(fd, data + done, size - done, MSG_NOSIGNAL) : ::write(fd, data + done, size - done);
+#else
+        (void) is_socket;
+        const auto n = ::write(fd, data + done, size - done);
+#endif
+        if (n > 0) {
+            done += static_cast<std::size_t>(n);
+        } else if (n < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+}// namespace
+
+/**
+ * @brief 固定大小的工作线程池，每个线程持有一个常驻 Solver，任务队列有界
+ */
+class WorkerPool {
+public:
+    using Task = std::function<void(Solver &)>;
+
+    WorkerPool(int workers, std::size_t capacity, const SolverConfig &config) : capacity_(std::max<std::size_t>(capacity, 1)) {
+        if (workers <= 0) { workers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); }
+        threads_.reserve(workers);
+        for (int i = 0; i < workers; ++i) {
+            threads_.emplace_back([this, config] { run(config); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        not_empty_.notify_all();
+        for (auto &thread: threads_) { thread.join(); }
+    }
+
+    // 队列满时阻塞，直到有空位
+    void submit(Task task) {
+        std::unique_lock lock(mutex_);
+        not_full_.wait(lock, [this] { return tasks_.size() < capacity_; });
+        tasks_.push_back(std::move(task));
+        not_empty_.notify_one();
+    }
+
+    // 等待队列清空且没有正在执行的任务
+    void wait_idle() {
+        std::unique_lock lock(mutex_);
+        idle_.wait(lock, [this] { return tasks_.empty() && active_ == 0; });
+    }
+
+private:
+    std::size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable not_empty_, not_full_, idle_;
+    std::deque<Task> tasks_;
+    std::size_t active_{0};
+    bool stopping_{false};
+    std::vector<std::thread> threads_;
+
+    void run(const SolverConfig &config) {
+        Solver solver(config);
+        while (true) {
+            Task task;
+            {
+                std::unique_lock lock(mutex_);
+                not_empty_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (tasks_.empty()) { return; }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+                ++active_;
+            }
+            not_full_.notify_one();
+            task(solver);
+            {
+                std::lock_guard lock(mutex_);
+                --active_;
+                if (tasks_.empty() && active_ == 0) { idle_.notify_all(); }
+            }
+        }
+    }
+};
+
+struct SolverServer::Connection {
+    int in_fd;
+    int out_fd;
+    bool owns_fd;
+    std::mutex write_mutex;
+
+    Connection(int in, int out, bool owns) : in_fd(in), out_fd(out), owns_fd(owns) {}
+
+    ~Connection() {
+#ifdef QM_HAS_UNIX_SOCKET
+        if (owns_fd) { ::close(in_fd); }
+#endif
+    }
+
+    void send(std::uint64_t request_id, ResponseStatus status, const SolverResult *result, std::string_view message = {}) {
+        binary::Bytes frame;
+        frame.reserve(4 + RESPONSE_HEADER_SIZE + (result ? binary::solution_record_size(static_cast<int>(result->solution.solution.size())) : message.size()));
+        append_le<std::uint32_t>(frame, 0);// 占位，稍后回填负载长度
+        append_le<std::uint64_t>(frame, request_id);
+        append_le<std::uint32_t>(frame, static_cast<std::uint8_t>(status));
+        append_le<std::uint32_t>(frame, static_cast<std::uint32_t>(result ? result->conflicts : -1));
+        append_le<std::uint64_t>(frame, result ? result->iterations : 0);
+        append_le<std::uint64_t>(frame, std::bit_cast<std::uint64_t>(result ? result->elapsed_seconds : 0.0));
+        if (result != nullptr) {
+            binary::encode_solution(result->solution, frame);
+        } else {
+            frame.insert(frame.end(), message.begin(), message.end());
+        }
+        const auto payload = static_cast<std::uint32_t>(frame.size() - 4);
+        for (int i = 0; i < 4; ++i) { frame[i] = static_cast<std::uint8_t>(payload >> (8 * i)); }
+
+#ifdef QM_HAS_UNIX_SOCKET
+        std::lock_guard lock(write_mutex);
+        write_full(out_fd, frame.data(), frame.size(), owns_fd);
+#endif
+    }
+};
+
+SolverServer::SolverServer(const ServerConfig &config) : config_(config) {
+    SolverConfig solver_config;
+    solver_config.search         = config_.search;
+    solver_config.cache_dir      = config_.cache_dir;
+    solver_config.cache_capacity = config_.cache_capacity;
+    pool_                        = std::make_unique<WorkerPool>(config_.workers, config_.queue_capacity, solver_config);
+}
+
+SolverServer::~SolverServer() {
+    stop();
+    for (auto &[thread, finished]: connection_threads_) {
+        if (thread.joinable()) { thread.join(); }
+    }
+    pool_.reset();
+}
+
+void SolverServer::handle_connection(const std::shared_ptr<Connection> &connection) {
+#ifdef QM_HAS_UNIX_SOCKET
+    binary::Bytes payload;
+    while (!stopping_.load()) {
+        std::uint64_t request_id = 0;
+        try {
+            std::uint8_t size_buffer[4];
+            if (!read_full(connection->in_fd, size_buffer, sizeof(size_buffer))) { break; }
+            const auto size = load_le<std::uint32_t>(size_buffer);
+            if (size < REQUEST_HEADER_SIZE || size > config_.max_frame_size) { throw std::runtime_error("Invalid request frame size"); }
+            payload.resize(size);
+            if (!read_full(connection->in_fd, payload.data(), payload.size())) { throw std::runtime_error("Truncated request frame"); }
+        } catch (const std::exception &e) {
+            // 帧边界已丢失，无法继续在该连接上解析
+            connection->send(request_id, ResponseStatus::ERROR, nullptr, e.what());
+            break;
+        }
+
+        const auto received    = Clock::now();
+        request_id             = load_le<std::uint64_t>(payload.data());
+        const auto deadline_ms = load_le<std::uint32_t>(payload.data() + 8);
+        const auto seed        = load_le<std::uint32_t>(payload.data() + 12);
+        std::shared_ptr<Instance> instance;
+        try {
+            instance = std::make_shared<Instance>(binary::decode_instance(binary::ByteSpan{payload}.subspan(REQUEST_HEADER_SIZE)));
+            // 颜色域按固定容量的位集存储，超出容量的规模不能求解
+            if (instance->size() > ColorDomain::MAX_SET_SIZE) {
+                throw std::runtime_error("Instance size " + std::to_string(instance->size()) + " exceeds the supported maximum " + std::to_string(ColorDomain::MAX_SET_SIZE));
+            }
+        } catch (const std::exception &e) {
+            connection->send(request_id, ResponseStatus::ERROR, nullptr, e.what());
+            continue;
+        }
+        const double budget = deadline_ms > 0 ? deadline_ms / 1000.0 : config_.default_deadline_seconds;
+        const auto deadline = received + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(budget));
+
+        pool_->submit([this, connection, request_id, seed, deadline, instance](Solver &solver) {
+            const double remaining = std::chrono::duration<double>(deadline - Clock::now()).count();
+            if (remaining <= 0) {
+                connection->send(request_id, ResponseStatus::EXPIRED, nullptr, "deadline expired before the request was scheduled");
+                return;
+            }
+            try {
+                SolverConfig solver_config;
+                solver_config.search             = config_.search;
+                solver_config.cache_dir          = config_.cache_dir;
+                solver_config.cache_capacity     = config_.cache_capacity;
+                solver_config.time_limit_seconds = remaining;
+                solver_config.seed               = seed;
+                solver.set_config(solver_config);
+                const auto result = solver.solve(instance);
+                connection->send(request_id, result.solved() ? ResponseStatus::SOLVED : ResponseStatus::BEST_EFFORT, &result);
+            } catch (const std::exception &e) {
+                connection->send(request_id, ResponseStatus::ERROR, nullptr, e.what());
+            }
+        });
+    }
+#else
+    (void) connection;
+#endif
+}
+
+void SolverServer::serve_stream(int in_fd, int out_fd) {
+    const auto connection = std::make_shared<Connection>(in_fd, out_fd, false);
+    {
+        std::lock_guard lock(connections_mutex_);
+        connections_.push_back(connection);
+    }
+    handle_connection(connection);
+    pool_->wait_idle();
+}
+
+void SolverServer::serve_unix_socket(const std::string &path) {
+#ifdef QM_HAS_UNIX_SOCKET
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) { throw std::runtime_error("Socket path too long: " + path); }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) { throw std::runtime_error(std::string("socket failed: ") + std::strerror(errno)); }
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || ::listen(fd, 64) != 0) {
+        const std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("Cannot listen on " + path + ": " + reason);
+    }
+    listen_fd_.store(fd);
+
+    while (!stopping_.load()) {
+        const int client = ::accept(fd, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR && !stopping_.load()) { continue; }
+            break;
+        }
+        const auto connection = std::make_shared<Connection>(client, client, true);
+        std::lock_guard lock(connections_mutex_);
+        std::erase_if(connections_, [](const auto &weak) { return weak.expired(); });
+        std::erase_if(connection_threads_, [](ConnectionThread &entry) {
+            if (!entry.finished->load()) { return false; }
+            entry.thread.join();
+            return true;
+        });
+        connections_.push_back(connection);
+        auto finished = std::make_shared<std::atomic<bool>>(false);
+        connection_threads_.push_back({std::thread([this, connection, finished] {
+                                           handle_connection(connection);
+                                           finished->store(true);
+                                       }),
+                                       finished});
+    }
+
+    if (const int listening = listen_fd_.exchange(-1); listening >= 0) { ::close(listening); }
+    ::unlink(path.c_str());
+    std::vector<ConnectionThread> threads;
+    {
+        std::lock_guard lock(connections_mutex_);
+        threads.swap(connection_threads_);
+    }
+    for (auto &[thread, finished]: threads) { thread.join(); }
+    pool_->wait_idle();
+#else
+    (void) path;
+    throw std::runtime_error("Unix domain sockets are not supported on this platform");
+#endif
+}
+
+void SolverServer::stop() {
+    stopping_.store(true);
+#ifdef QM_HAS_UNIX_SOCKET
+    if (const int fd = listen_fd_.exchange(-1); fd >= 0) {
+        ::shutdown(fd, SHUT_RDWR);
+        ::close(fd);
+    }
+    std::lock_guard lock(connections_mutex_);
+    for (const auto &weak: connections_) {
+        if (const auto connection = weak.lock(); connection && connection->owns_fd) { ::shutdown(connection->in_fd, SHUT_RD); }
+    }
+#endif
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,122 @@
+#include "latin_square/solution_cache.h"
+
+#include "latin_square/binary_io.h"
+#include "latin_square/zobrist.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace qm::latin_square {
+
+namespace fs = std::filesystem;
+
+namespace {
+constexpr auto ENTRY_EXTENSION = ".lsc";
+
+std::string to_hex(const std::uint64_t value) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+// 映射回的解必须满足原实例的全部固定格且没有冲突
+bool is_valid_solution(const Instance &instance, const Solution &solution) {
+    if (solution.total_conflict != 0) { return false; }
+    return std::all_of(instance.get_fixed().begin(), instance.get_fixed().end(), [&solution](const Assignment &assignment) {
+        return solution.get_color(assignment.row, assignment.col) == assignment.num;
+    });
+}
+
+bool same_instance(const Instance &a, const Instance &b) {
+    return a.size() == b.size() && std::equal(a.get_fixed().begin(), a.get_fixed().end(), b.get_fixed().begin(), b.get_fixed().end(), [](const Assignment &x, const Assignment &y) {
+               return x.row == y.row && x.col == y.col && x.num == y.num;
+           });
+}
+}// namespace
+
+SolutionCache::SolutionCache(std::string directory, const std::size_t capacity) : directory_(std::move(directory)), capacity_(capacity) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    if (ec) { throw std::runtime_error("Cannot create cache directory " + directory_ + ": " + ec.message()); }
+}
+
+fs::path SolutionCache::entry_path_(const CanonicalForm &form) const { return fs::path(directory_) / (to_hex(form.hash) + ENTRY_EXTENSION); }
+
+std::optional<Solution> SolutionCache::lookup(const Instance &instance) const { return lookup(instance, canonicalize(instance)); }
+
+std::optional<Solution> SolutionCache::lookup(const Instance &instance, const CanonicalForm &form) const {
+    const auto path = entry_path_(form);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { return std::nullopt; }
+    const binary::Bytes bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    try {
+        std::size_t consumed = 0;
+        const auto stored    = binary::decode_instance(bytes, &consumed);
+        if (!same_instance(stored, form.instance)) { return std::nullopt; }
+        const auto canonical = binary::decode_solution(binary::ByteSpan(bytes).subspan(consumed));
+        if (canonical.solution.size() != static_cast<std::size_t>(instance.size())) { return std::nullopt; }
+        auto solution = form.from_canonical(canonical);
+        if (!is_valid_solution(instance, solution)) { return std::nullopt; }
+        // 刷新修改时间，作为最近使用时间
+        std::error_code ec;
+        fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+        return solution;
+    } catch (const std::exception &) { return std::nullopt; }
+}
+
+bool SolutionCache::store(const Instance &instance, const Solution &solution) const { return store(canonicalize(instance), solution); }
+
+bool SolutionCache::store(const CanonicalForm &form, const Solution &solution) const {
+    if (capacity_ == 0 || solution.total_conflict != 0) { return false; }
+    binary::Bytes bytes;
+    binary::encode_instance(form.instance, bytes);
+    binary::encode_solution(form.to_canonical(solution), bytes);
+
+    // 临时文件名对每个写入者唯一，避免并发写入同一条目时互相覆盖
+    const auto path   = entry_path_(form);
+    const auto writer = zobrist::mix(std::hash<std::thread::id>{}(std::this_thread::get_id()) ^ std::chrono::steady_clock::now().time_since_epoch().count());
+    auto temp_path    = path;
+    temp_path += ".tmp." + to_hex(writer);
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size())) || !out.flush()) {
+            out.close();
+            std::error_code ec;
+            fs::remove(temp_path, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(temp_path, path, ec);
+    if (ec) {
+        fs::remove(temp_path, ec);
+        return false;
+    }
+    evict_();
+    return true;
+}
+
+void SolutionCache::evict_() const {
+    std::vector<std::pair<fs::file_time_type, fs::path>> entries;
+    std::error_code ec;
+    for (fs::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() != ENTRY_EXTENSION) { continue; }
+        std::error_code time_ec;
+        const auto time = it->last_write_time(time_ec);
+        if (!time_ec) { entries.emplace_back(time, it->path()); }
+    }
+    if (entries.size() <= capacity_) { return; }
+    const auto excess = entries.size() - capacity_;
+    std::nth_element(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(excess), entries.end());
+    // 其它写入者可能已删除同一条目，忽略失败
+    for (std::size_t index = 0; index < excess; ++index) { fs::remove(entries[index].second, ec); }
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,55 @@
+#include "latin_square/solution_writer.h"
+
+#include <charconv>
+#include <ostream>
+#include <stdexcept>
+
+namespace qm::latin_square {
+
+namespace {
+std::size_t decimal_digits(std::size_t value) {
+    std::size_t digits = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++digits;
+    }
+    return digits;
+}
+}// namespace
+
+std::size_t SolutionWriter::max_formatted_size(const std::size_t n) {
+    // 每个数字最多 digits 位，后跟一个空格或换行；额外预留一个分隔空行
+    return n * n * (decimal_digits(n > 0 ? n - 1 : 0) + 1) + 1;
+}
+
+std::string_view SolutionWriter::format(const Solution &solution, const bool trailing_blank_line) {
+    const auto n        = solution.solution.size();
+    const auto capacity = max_formatted_size(n);
+    if (buffer_.size() < capacity) { buffer_.resize(capacity); }
+
+    char *out       = buffer_.data();
+    char *const end = buffer_.data() + buffer_.size();
+    for (const auto &row: solution.solution) {
+        for (std::size_t i = 0; i < row.size(); ++i) {
+            if (i > 0) { *out++ = ' '; }
+            const auto [ptr, ec] = std::to_chars(out, end, row[i]);
+            if (ec != std::errc{}) { throw std::runtime_error("Solution value does not fit the output buffer"); }
+            out = ptr;
+        }
+        *out++ = '\n';
+    }
+    if (trailing_blank_line) { *out++ = '\n'; }
+    return {buffer_.data(), static_cast<std::size_t>(out - buffer_.data())};
+}
+
+void SolutionWriter::write(std::ostream &os, const Solution &solution, const bool trailing_blank_line) {
+    const auto text = format(solution, trailing_blank_line);
+    os.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+void SolutionWriter::write(std::FILE *file, const Solution &solution, const bool trailing_blank_line) {
+    const auto text = format(solution, trailing_blank_line);
+    if (std::fwrite(text.data(), 1, text.size(), file) != text.size()) { throw std::runtime_error("Failed to write solution"); }
+}
+
+}// namespace qm::latin_square
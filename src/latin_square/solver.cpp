@@ -0,0 +1,246 @@
+#include "latin_square/solver.h"
+
+#include "utils/RandomGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace qm::latin_square {
+
+SolverResult Solver::solve(std::shared_ptr<Instance> instance, const std::atomic<bool> *stop_flag) { return solve_cached_(std::move(instance), nullptr, stop_flag); }
+
+SolverResult Solver::solve_from(std::shared_ptr<Instance> instance, const Solution &warm_start, const std::atomic<bool> *stop_flag) {
+    return solve_cached_(std::move(instance), &warm_start, stop_flag);
+}
+
+SolverResult Solver::solve_cached_(std::shared_ptr<Instance> instance, const Solution *warm_start, const std::atomic<bool> *stop_flag) {
+    if (config_.cache_dir.empty()) { return solve_(std::move(instance), warm_start, stop_flag); }
+    if (!cache_ || cache_->directory() != config_.cache_dir || cache_->capacity() != config_.cache_capacity) {
+        cache_ = std::make_unique<SolutionCache>(config_.cache_dir, config_.cache_capacity);
+    }
+
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto form       = canonicalize(*instance);
+    if (auto solution = cache_->lookup(*instance, form)) {
+        if (on_improvement_) { on_improvement_(*solution, 0); }
+        SolverResult result;
+        result.solution        = std::move(*solution);
+        result.cached          = true;
+        result.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+        return result;
+    }
+    auto result = solve_(std::move(instance), warm_start, stop_flag);
+    if (result.solved()) {
+        cache_->store(form, result.solution);
+        result.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    }
+    return result;
+}
+
+SolverResult Solver::solve_(std::shared_ptr<Instance> instance, const Solution *warm_start, const std::atomic<bool> *stop_flag) {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    if (config_.seed) { setRandomSeed(*config_.seed); }
+
+    // 初始化拉丁方
+    LatinSquare latin_square(std::move(instance));
+    // 检查点按完整实例保存与恢复，写检查点时不收缩；热启动的旧解属于完整实例，也不收缩
+    if (config_.shrink && config_.checkpoint_path.empty() && warm_start == nullptr) {
+        if (const auto reduction = Reduction::analyze(latin_square)) {
+            auto result            = solve_reduced_(*reduction, stop_flag, start_time);
+            result.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+            return result;
+        }
+    }
+    return search_(latin_square, warm_start, stop_flag, start_time);
+}
+
+SolverResult Solver::search_(LatinSquare &latin_square, const Solution *warm_start, const std::atomic<bool> *stop_flag, const std::chrono::steady_clock::time_point start_time) {
+    const auto elapsed = [start_time] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count(); };
+
+    SolverResult result;
+    Solution solution;
+    int repair_swaps = -1;
+    if (warm_start != nullptr) {
+        solution            = repair_solution(latin_square, *warm_start, &repair_swaps);
+        result.repair_swaps = repair_swaps;
+    } else {
+        solution = latin_square.generate_init_solution();
+    }
+
+    if (solution.total_conflict == 0) {
+        if (on_improvement_) { on_improvement_(solution, 0); }
+        result.solution        = std::move(solution);
+        result.elapsed_seconds = elapsed();
+        return result;
+    }
+
+    const auto kind = config_.engine == EngineKind::AUTO
+                              ? select_engine(extract_features(latin_square), config_.selector, std::max(1u, std::thread::hardware_concurrency()))
+                              : config_.engine;
+
+    // 化简后剩余的非固定格很少时，先用有限节点数的精确搜索试一次，能直接解出或证明无解
+    if (kind != EngineKind::EXACT && config_.exact.auto_max_free_cells > 0 && ExactSearch::free_cells(latin_square) <= config_.exact.auto_max_free_cells) {
+        // 先试只占用一部分时间（0 表示不限时，因此不会取到 0）
+        const double exact_limit = config_.time_limit_seconds > 0 ? std::max(config_.time_limit_seconds * config_.exact.auto_time_fraction, 1e-3) : 0;
+        auto &exact              = prepare_exact_search_(stop_flag);
+        exact.search(latin_square, solution, config_.exact.auto_node_budget, exact_limit);
+        if (exact.status() != ExactStatus::UNKNOWN) {
+            result              = collect_result_(exact, stop_flag, elapsed());
+            result.infeasible   = exact.status() == ExactStatus::INFEASIBLE;
+            result.engine       = EngineKind::EXACT;
+            result.repair_swaps = repair_swaps;
+            return result;
+        }
+    }
+
+    // 引擎只得到剩余的时间，总耗时不超过时间限制；剩余时间耗尽时给一个极短的时限（0 表示不限时）
+    const double time_limit = config_.time_limit_seconds > 0 ? std::max(config_.time_limit_seconds - elapsed(), 1e-3) : 0;
+    auto &engine            = prepare_engine_(kind, stop_flag);
+    engine.search(latin_square, solution, config_.max_iterations, time_limit);
+    result              = collect_result_(engine, stop_flag, elapsed());
+    result.engine       = kind;
+    result.repair_swaps = repair_swaps;
+    if (kind == EngineKind::EXACT) { result.infeasible = exact_search_->status() == ExactStatus::INFEASIBLE; }
+    return result;
+}
+
+SolverResult Solver::solve_reduced_(const Reduction &reduction, const std::atomic<bool> *stop_flag, const std::chrono::steady_clock::time_point start_time) {
+    const auto outer = on_improvement_;
+    if (outer) {
+        on_improvement_ = [&reduction, &outer](const Solution &best, const unsigned long long iteration) { outer(reduction.lift(best), iteration); };
+    }
+    SolverResult result;
+    try {
+        // 不重设随机种子，时间限制从收缩分析之前开始计算
+        LatinSquare reduced(reduction.instance());
+        result = search_(reduced, nullptr, stop_flag, start_time);
+    } catch (...) {
+        on_improvement_ = outer;
+        throw;
+    }
+    on_improvement_     = outer;
+    result.solution     = reduction.lift(result.solution);
+    result.conflicts    = result.solution.total_conflict;
+    result.reduced_size = reduction.reduced_size();
+    return result;
+}
+
+SolverResult Solver::resume(std::shared_ptr<Instance> instance, const SearchCheckpoint &checkpoint, const std::atomic<bool> *stop_flag) {
+    const auto start_time = std::chrono::steady_clock::now();
+
+    checkpoint.check_instance(*instance);
+    LatinSquare latin_square(std::move(instance));
+    prepare_local_search_(stop_flag);
+    local_search_.resume(latin_square, checkpoint, config_.max_iterations, config_.time_limit_seconds);
+    return collect_result_(local_search_, stop_flag, std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+}
+
+SearchEngine &Solver::prepare_engine_(const EngineKind kind, const std::atomic<bool> *stop_flag) {
+    if (kind == EngineKind::TABU) {
+        prepare_local_search_(stop_flag);
+        return local_search_;
+    }
+    if (kind == EngineKind::ANNEALING) {
+        if (!annealing_search_) { annealing_search_ = std::make_unique<AnnealingSearch>(); }
+        annealing_search_->set_config(config_.annealing);
+        annealing_search_->set_improvement_callback(on_improvement_);
+        annealing_search_->set_stop_flag(stop_flag);
+        return *annealing_search_;
+    }
+    if (kind == EngineKind::EXACT) { return prepare_exact_search_(stop_flag); }
+    if (kind == EngineKind::PORTFOLIO) {
+        if (!portfolio_search_) { portfolio_search_ = std::make_unique<PortfolioSearch>(); }
+        portfolio_search_->clear_members();
+        for (const auto member: config_.portfolio.engines) { portfolio_search_->add_member(make_portfolio_member_(member)); }
+        portfolio_search_->set_improvement_callback(on_improvement_);
+        portfolio_search_->set_stop_flag(stop_flag);
+        return *portfolio_search_;
+    }
+    if (kind == EngineKind::MEMETIC) {
+        if (!memetic_search_) { memetic_search_ = std::make_unique<MemeticSearch>(); }
+        memetic_search_->set_config(config_.memetic);
+        memetic_search_->set_improvement_callback(on_improvement_);
+        memetic_search_->set_stop_flag(stop_flag);
+        return *memetic_search_;
+    }
+    if (!weighting_search_) { weighting_search_ = std::make_unique<WeightingSearch>(); }
+    weighting_search_->set_config(config_.weighting);
+    weighting_search_->set_improvement_callback(on_improvement_);
+    weighting_search_->set_stop_flag(stop_flag);
+    return *weighting_search_;
+}
+
+std::unique_ptr<SearchEngine> Solver::make_portfolio_member_(const EngineKind kind) const {
+    switch (kind) {
+        case EngineKind::TABU: {
+            auto search_config    = config_.search;
+            search_config.verbose = false;
+            return std::make_unique<LocalSearch>(search_config);
+        }
+        case EngineKind::WEIGHTING: {
+            auto weighting_config    = config_.weighting;
+            weighting_config.verbose = false;
+            return std::make_unique<WeightingSearch>(weighting_config);
+        }
+        case EngineKind::ANNEALING: {
+            auto annealing_config    = config_.annealing;
+            annealing_config.verbose = false;
+            return std::make_unique<AnnealingSearch>(annealing_config);
+        }
+        case EngineKind::MEMETIC: {
+            auto memetic_config    = config_.memetic;
+            memetic_config.verbose = false;
+            return std::make_unique<MemeticSearch>(memetic_config);
+        }
+        case EngineKind::EXACT: {
+            auto exact_config    = config_.exact;
+            exact_config.verbose = false;
+            return std::make_unique<ExactSearch>(exact_config);
+        }
+        default:
+            throw std::invalid_argument("Portfolio members must be concrete engines");
+    }
+}
+
+ExactSearch &Solver::prepare_exact_search_(const std::atomic<bool> *stop_flag) {
+    if (!exact_search_) { exact_search_ = std::make_unique<ExactSearch>(); }
+    exact_search_->set_config(config_.exact);
+    exact_search_->set_improvement_callback(on_improvement_);
+    exact_search_->set_stop_flag(stop_flag);
+    return *exact_search_;
+}
+
+void Solver::prepare_local_search_(const std::atomic<bool> *stop_flag) {
+    local_search_.set_config(config_.search);
+    local_search_.set_improvement_callback(on_improvement_);
+    local_search_.set_stop_flag(stop_flag);
+    if (config_.checkpoint_path.empty()) {
+        local_search_.set_checkpoint_callback(nullptr, 0);
+        return;
+    }
+    local_search_.set_checkpoint_callback(
+            [path = config_.checkpoint_path](const SearchCheckpoint &checkpoint) {
+                // 写检查点失败不应中断已经运行了很久的搜索
+                try {
+                    save_checkpoint(path, checkpoint);
+                } catch (const std::exception &e) { std::cerr << "警告: 检查点写入失败 - " << e.what() << std::endl; }
+            },
+            config_.checkpoint_interval_seconds);
+}
+
+SolverResult Solver::collect_result_(const SearchEngine &engine, const std::atomic<bool> *stop_flag, const double elapsed_seconds) {
+    SolverResult result;
+    result.solution        = engine.best_solution();
+    result.conflicts       = result.solution.total_conflict;
+    result.iterations      = engine.iteration();
+    result.cancelled       = stop_flag != nullptr && stop_flag->load(std::memory_order_relaxed);
+    result.elapsed_seconds = elapsed_seconds;
+    return result;
+}
+
+}// namespace qm::latin_square
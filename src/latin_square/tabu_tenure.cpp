@@ -0,0 +1,110 @@
+#include "latin_square/tabu_tenure.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace qm::latin_square {
+
+void TabuTenureController::reset(const TenureConfig &config, const double alpha, const int random_range) {
+    config_                     = config;
+    alpha_                      = alpha;
+    random_range_               = random_range;
+    last_cycle_iteration_       = 0;
+    last_improvement_iteration_ = 0;
+    pending_revisits_           = 0;
+    clear_history_();
+}
+
+void TabuTenureController::clear_history_() {
+    const int period = std::max(1, config_.max_cycle_period);
+    history_.assign(period + 1, 0);
+    match_runs_.assign(period, 0);
+    head_   = 0;
+    filled_ = 0;
+}
+
+void TabuTenureController::observe(const unsigned long long iteration, const int total_conflict, const bool best_improved, const bool revisited, SearchTelemetry &telemetry) {
+    telemetry.tabu_alpha        = alpha_;
+    telemetry.tabu_random_range = random_range_;
+    if (!config_.reactive) { return; }
+    if (best_improved) { last_improvement_iteration_ = iteration; }
+
+    // 与 p 步前的冲突数比较，更新各周期的连续匹配长度
+    const int capacity = static_cast<int>(history_.size());
+    const int periods  = std::min(static_cast<int>(match_runs_.size()), filled_);
+    if (revisited) {
+        ++telemetry.revisits;
+        ++pending_revisits_;
+    }
+    bool cycle = pending_revisits_ >= std::max(1, config_.revisit_threshold);
+    for (auto p = 1; p <= periods; ++p) {
+        auto &run = match_runs_[p - 1];
+        run       = history_[(head_ - p + capacity) % capacity] == total_conflict ? run + 1 : 0;
+        // 周期 1 的匹配表示冲突数保持不变（平移），不视为循环；周期 p 的窗口内冲突数须有变化
+        const int window = config_.cycle_repeats * p;
+        if (p >= 2 && run >= window && match_runs_[0] + 1 < window) { cycle = true; }
+    }
+    history_[head_] = total_conflict;
+    head_           = (head_ + 1) % capacity;
+    filled_         = std::min(filled_ + 1, capacity);
+
+    if (cycle) {
+        ++telemetry.cycles_detected;
+        adjust_(config_.increase_factor, config_.random_range_step, telemetry);
+        std::ranges::fill(match_runs_, 0);
+        pending_revisits_     = 0;
+        last_cycle_iteration_ = iteration;
+    } else if (iteration - last_cycle_iteration_ >= config_.decrease_interval) {
+        adjust_(config_.decrease_factor, -config_.random_range_step, telemetry);
+        pending_revisits_     = 0;
+        last_cycle_iteration_ = iteration;
+    }
+
+    if (iteration - last_improvement_iteration_ >= config_.plateau_length) {
+        ++telemetry.plateaus_detected;
+        adjust_(1.0, config_.random_range_step, telemetry);
+        last_improvement_iteration_ = iteration;
+    }
+}
+
+void TabuTenureController::adjust_(const double alpha_factor, const int range_delta, SearchTelemetry &telemetry) {
+    const double alpha = std::clamp(alpha_ * alpha_factor, config_.min_alpha, config_.max_alpha);
+    const int range    = std::clamp(random_range_ + range_delta, config_.min_random_range, config_.max_random_range);
+    if (alpha > alpha_ || range > random_range_) { ++telemetry.tenure_increases; }
+    if (alpha < alpha_ || range < random_range_) { ++telemetry.tenure_decreases; }
+    alpha_                      = alpha;
+    random_range_               = range;
+    telemetry.tabu_alpha        = alpha_;
+    telemetry.tabu_random_range = random_range_;
+}
+
+TabuTenureController::State TabuTenureController::state() const {
+    State state;
+    state.alpha                      = alpha_;
+    state.random_range               = random_range_;
+    state.last_cycle_iteration       = last_cycle_iteration_;
+    state.last_improvement_iteration = last_improvement_iteration_;
+    state.pending_revisits           = pending_revisits_;
+    const int capacity               = static_cast<int>(history_.size());
+    for (auto i = filled_; i > 0; --i) { state.recent_costs.push_back(history_[(head_ - i + capacity) % capacity]); }
+    state.match_runs = match_runs_;
+    return state;
+}
+
+void TabuTenureController::restore(const TenureConfig &config, const State &state) {
+    reset(config, state.alpha, state.random_range);
+    last_cycle_iteration_       = state.last_cycle_iteration;
+    last_improvement_iteration_ = state.last_improvement_iteration;
+    pending_revisits_           = state.pending_revisits;
+    if (state.recent_costs.size() > history_.size() || state.match_runs.size() != match_runs_.size()) {
+        throw std::runtime_error("tabu tenure state does not match the configured cycle period");
+    }
+    for (const auto cost: state.recent_costs) {
+        history_[head_] = cost;
+        head_           = (head_ + 1) % static_cast<int>(history_.size());
+    }
+    filled_     = static_cast<int>(state.recent_costs.size());
+    match_runs_ = state.match_runs;
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,16 @@
+#include "latin_square/telemetry.h"
+
+#include <ostream>
+
+namespace qm::latin_square {
+
+std::ostream &operator<<(std::ostream &os, const SearchTelemetry &telemetry) {
+    return os << "improvements=" << telemetry.improvements << " restarts=" << telemetry.restarts << " perturbation_swaps=" << telemetry.perturbation_swaps
+              << " relinks=" << telemetry.relinks << " candidate_scans=" << telemetry.candidate_scans
+              << " candidate_fallbacks=" << telemetry.candidate_fallbacks << " revisits=" << telemetry.revisits << " cycles=" << telemetry.cycles_detected << " plateaus=" << telemetry.plateaus_detected << " tenure_increases=" << telemetry.tenure_increases
+              << " tenure_decreases=" << telemetry.tenure_decreases << " tabu_alpha=" << telemetry.tabu_alpha << " tabu_random_range=" << telemetry.tabu_random_range
+              << " weight_increases=" << telemetry.weight_increases << " weight_smoothings=" << telemetry.weight_smoothings
+              << " reheats=" << telemetry.reheats << " backtracks=" << telemetry.backtracks << " offspring=" << telemetry.offspring << " offspring_accepted=" << telemetry.offspring_accepted;
+}
+
+}// namespace qm::latin_square
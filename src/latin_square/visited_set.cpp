@@ -0,0 +1,98 @@
+#include "latin_square/visited_set.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+namespace qm::latin_square {
+
+bool VisitedSet::Table::contains(const std::uint64_t key, const std::size_t mask) const {
+    // 哈希本身已充分混合，直接取低位作为起始槽
+    for (auto slot = static_cast<std::size_t>(key) & mask;; slot = (slot + 1) & mask) {
+        if (slots[slot] == key) { return true; }
+        if (slots[slot] == 0) { return false; }
+    }
+}
+
+void VisitedSet::Table::insert(const std::uint64_t key, const std::size_t mask) {
+    for (auto slot = static_cast<std::size_t>(key) & mask;; slot = (slot + 1) & mask) {
+        if (slots[slot] == key) { return; }
+        if (slots[slot] == 0) {
+            slots[slot] = key;
+            ++size;
+            return;
+        }
+    }
+}
+
+void VisitedSet::Table::clear() {
+    std::ranges::fill(slots, 0);
+    size = 0;
+}
+
+void VisitedSet::set_window(const std::size_t window) {
+    window_ = window;
+    if (window_ == 0) {
+        mask_ = 0;
+        newer_.slots.clear();
+        older_.slots.clear();
+        newer_.size = older_.size = 0;
+        return;
+    }
+    const auto capacity = std::bit_ceil(window_ * 2);
+    mask_               = capacity - 1;
+    newer_.slots.assign(capacity, 0);
+    older_.slots.assign(capacity, 0);
+    newer_.size = older_.size = 0;
+}
+
+bool VisitedSet::visit(const std::uint64_t hash) {
+    if (window_ == 0) { return false; }
+    const auto key = key_of(hash);
+    if (newer_.contains(key, mask_)) { return true; }
+    const bool seen = older_.contains(key, mask_);
+    insert_(key);
+    return seen;
+}
+
+void VisitedSet::insert_(const std::uint64_t key) {
+    if (newer_.size >= window_) {
+        // 新一代写满：降为旧一代，原旧一代清空后作为新一代复用
+        std::swap(newer_, older_);
+        newer_.clear();
+    }
+    newer_.insert(key, mask_);
+}
+
+bool VisitedSet::contains(const std::uint64_t hash) const {
+    if (window_ == 0) { return false; }
+    const auto key = key_of(hash);
+    return newer_.contains(key, mask_) || older_.contains(key, mask_);
+}
+
+void VisitedSet::clear() {
+    newer_.clear();
+    older_.clear();
+}
+
+void VisitedSet::export_generations(std::vector<std::uint64_t> &older, std::vector<std::uint64_t> &newer) const {
+    const auto collect = [](const Table &table, std::vector<std::uint64_t> &out) {
+        out.clear();
+        for (const auto key: table.slots) {
+            if (key != 0) { out.push_back(key); }
+        }
+    };
+    collect(older_, older);
+    collect(newer_, newer);
+}
+
+void VisitedSet::restore_generations(const std::vector<std::uint64_t> &older, const std::vector<std::uint64_t> &newer) {
+    clear();
+    if (window_ == 0) { return; }
+    if (older.size() > window_ || newer.size() > window_) { throw std::runtime_error("visited set does not fit the configured window"); }
+    for (const auto key: older) { older_.insert(key_of(key), mask_); }
+    for (const auto key: newer) { newer_.insert(key_of(key), mask_); }
+}
+
+}// namespace qm::latin_square
@@ -0,0 +1,225 @@
+#include "latin_square/weighting_search.h"
+
+#include "latin_square/zobrist.h"
+#include "utils/RandomGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+namespace qm::latin_square {
+
+void WeightingSearch::search(const LatinSquare &latin_square, const Solution &solution, const unsigned long long max_iteration, const double time_limit_seconds) {
+    run_(latin_square, solution, max_iteration, time_limit_seconds);
+    // 搜索返回后不再引用调用方的拉丁方
+    latin_square_ = nullptr;
+    evaluator_.detach();
+}
+
+void WeightingSearch::run_(const LatinSquare &latin_square, const Solution &solution, const unsigned long long max_iteration, const double time_limit_seconds) {
+    const int N = latin_square.get_instance_size();
+    prepare_workspace_(N);
+    N_                = N;
+    latin_square_     = &latin_square;
+    current_solution_ = solution;
+    best_solution_    = solution;
+    iteration_        = 0;
+    telemetry_.reset();
+    evaluator_.reset(latin_square, solution);
+    row_grid_.rebuild(latin_square, evaluator_, current_solution_);
+    weight_.assign(static_cast<size_t>(N) * N, 1);
+    conf_changed_.assign(static_cast<size_t>(N) * N, 1);
+    last_moved_.assign(static_cast<size_t>(N) * N, 0);
+
+    const auto start_time = std::chrono::high_resolution_clock::now();
+    const auto elapsed    = [&start_time] { return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start_time).count(); };
+
+    while (iteration_ < max_iteration) {
+        if (stop_flag_ != nullptr && stop_flag_->load(std::memory_order_relaxed)) {
+            if (config_.verbose) { std::clog << "收到停止请求，搜索终止，最终冲突数: " << best_solution_.total_conflict << std::endl; }
+            return;
+        }
+        if (time_limit_seconds > 0 && elapsed() >= time_limit_seconds) {
+            if (config_.verbose) {
+                std::clog << "达到时间限制 " << time_limit_seconds << " 秒，搜索终止" << std::endl;
+                std::clog << "最终冲突数: " << best_solution_.total_conflict << std::endl;
+                std::clog << "遥测: " << telemetry_ << std::endl;
+            }
+            return;
+        }
+
+        auto move = find_move_(true);
+        if (move.row_id < 0) {
+            // 加权意义下的局部最优：调整权重后执行允许的最优移动，都不允许时随机游走一步
+            update_weights_();
+            move = find_move_(false);
+            if (move.row_id < 0) { move = random_walk_move_(); }
+            if (move.row_id < 0) { throw std::runtime_error("No valid move found in WeightingSearch"); }
+        }
+        make_move_(move);
+        update_best_();
+
+        if (current_solution_.total_conflict == 0) {
+            if (config_.verbose) {
+                std::clog << "Iteration: " << iteration_ << " conflict = 0, return." << std::endl;
+                std::clog << "求解时间: " << std::fixed << std::setprecision(3) << elapsed() << " s" << std::endl;
+                std::clog << "遥测: " << telemetry_ << std::endl;
+            }
+            return;
+        }
+        ++iteration_;
+    }
+
+    if (config_.verbose) {
+        std::clog << "搜索结束，总时间: " << std::fixed << std::setprecision(3) << elapsed() << " s" << std::endl;
+        std::clog << "最终冲突数: " << best_solution_.total_conflict << std::endl;
+        std::clog << "遥测: " << telemetry_ << std::endl;
+    }
+}
+
+void WeightingSearch::prepare_workspace_(const int N) {
+    if (!workspace_.needs_growth(N)) { return; }
+    // 出现了更大的规模：先归还所有从工作区分配的结构，再整体重置并扩容
+    evaluator_.release();
+    row_grid_.release();
+    std::pmr::vector<long long>(weight_.get_allocator()).swap(weight_);
+    std::pmr::vector<std::uint8_t>(conf_changed_.get_allocator()).swap(conf_changed_);
+    std::pmr::vector<unsigned long long>(last_moved_.get_allocator()).swap(last_moved_);
+    workspace_.grow(N);
+}
+
+bool WeightingSearch::update_best_() {
+    if (!(current_solution_ <= best_solution_)) { return false; }
+    const bool improved = current_solution_.total_conflict < best_solution_.total_conflict;
+    best_solution_      = current_solution_;
+    if (improved) {
+        ++telemetry_.improvements;
+        if (on_improvement_) { on_improvement_(best_solution_, iteration_); }
+    }
+    return improved;
+}
+
+long long WeightingSearch::weighted_delta_(const Move &move) const {
+    const auto color1 = current_solution_.get_color(move.row_id, move.col1);
+    const auto color2 = current_solution_.get_color(move.row_id, move.col2);
+    if (color1 == color2) { return 0; }
+    // (颜色, 列) 对的格子数由 k 变为 k - 1 时格子对数减少 k - 1，由 k 变为 k + 1 时增加 k
+    const auto w = [this](const int color, const int col) { return weight_[color * N_ + col]; };
+    return -w(color1, move.col1) * (evaluator_.color_count(color1, move.col1) - 1) + w(color1, move.col2) * evaluator_.color_count(color1, move.col2)
+           - w(color2, move.col2) * (evaluator_.color_count(color2, move.col2) - 1) + w(color2, move.col1) * evaluator_.color_count(color2, move.col1);
+}
+
+Move WeightingSearch::find_move_(const bool descending_only) const {
+    Move best_move{-1, -1, -1};
+    long long best_delta1 = descending_only ? 0 : std::numeric_limits<long long>::max();
+    int best_delta2       = std::numeric_limits<int>::max();
+    int move_num          = 0;
+
+    const auto consider = [&](const Move &move) {
+        const auto delta1 = weighted_delta_(move);
+        if (delta1 > best_delta1 || (descending_only && delta1 >= 0)) { return; }
+        // 配置检测：两格都未因邻居变化而解除限制时，只有能改进历史最优解的移动可以通过（特赦）
+        if (conf_changed_[move.row_id * N_ + move.col1] == 0 && conf_changed_[move.row_id * N_ + move.col2] == 0
+            && current_solution_.total_conflict + evaluator_.evaluate_conflict_delta(current_solution_, move) >= best_solution_.total_conflict) {
+            return;
+        }
+        const auto delta2 = evaluator_.evaluate_domain_delta(current_solution_, move);
+        if (delta1 < best_delta1 || delta2 < best_delta2) {
+            best_delta1 = delta1;
+            best_delta2 = delta2;
+            best_move   = move;
+            move_num    = 1;
+        } else if (delta2 == best_delta2) {
+            ++move_num;
+            if (randomInt(move_num) == 0) { best_move = move; }
+        }
+    };
+
+    for (auto row = 0; row < N_; ++row) {
+        const auto &conflict_cols    = row_grid_.conflict(row);
+        const auto &nonconflict_cols = row_grid_.nonconflict(row);
+        // 冲突节点 - 冲突节点
+        for (auto i = 0; i < conflict_cols.size(); ++i) {
+            for (auto j = i + 1; j < conflict_cols.size(); ++j) { consider(Move{row, conflict_cols[i], conflict_cols[j]}); }
+        }
+        // 冲突节点 - 非冲突节点
+        for (const auto col1: conflict_cols) {
+            for (const auto col2: nonconflict_cols) { consider(Move{row, col1, col2}); }
+        }
+    }
+    return best_move;
+}
+
+Move WeightingSearch::random_walk_move_() const {
+    // 均匀选择一个有冲突节点且至少两个非固定格的行
+    int row     = -1;
+    int row_num = 0;
+    for (auto r = 0; r < N_; ++r) {
+        if (row_grid_.conflict(r).empty() || row_grid_.free_count(r) < 2) { continue; }
+        ++row_num;
+        if (randomInt(row_num) == 0) { row = r; }
+    }
+    if (row < 0) { return Move{-1, -1, -1}; }
+
+    const auto &conflict_cols = row_grid_.conflict(row);
+    const int col1            = conflict_cols[randomInt(conflict_cols.size())];
+    Move best_move{-1, -1, -1};
+    long long best_delta = std::numeric_limits<long long>::max();
+    for (const auto *cols: {&conflict_cols, &row_grid_.nonconflict(row)}) {
+        for (const auto col2: *cols) {
+            if (col2 == col1) { continue; }
+            const Move move{row, col1, col2};
+            const auto delta = weighted_delta_(move);
+            // 平局时选择最久未移动的格子
+            if (delta < best_delta || (delta == best_delta && last_moved_[row * N_ + col2] < last_moved_[row * N_ + best_move.col2])) {
+                best_delta = delta;
+                best_move  = move;
+            }
+        }
+    }
+    return best_move;
+}
+
+void WeightingSearch::update_weights_() {
+    if (randomDouble(0.0, 1.0) < config_.smoothing_probability) {
+        // 平滑：降低所有增长过的权重，让早期的局部最优逐渐被遗忘
+        for (auto &w: weight_) {
+            if (w > 1) { --w; }
+        }
+        ++telemetry_.weight_smoothings;
+        return;
+    }
+    for (auto color = 0; color < N_; ++color) {
+        for (auto col = 0; col < N_; ++col) {
+            if (evaluator_.is_conflict_grid(color, col)) { ++weight_[color * N_ + col]; }
+        }
+    }
+    ++telemetry_.weight_increases;
+}
+
+void WeightingSearch::make_move_(const Move &move) {
+    const auto move_delta1    = evaluator_.evaluate_conflict_delta(current_solution_, move);
+    const auto move_delta2    = evaluator_.evaluate_domain_delta(current_solution_, move);
+    const auto affected_cells = evaluator_.update(current_solution_, move);
+    current_solution_.total_conflict += move_delta1;
+    current_solution_.domain_conflict += move_delta2;
+    current_solution_.hash ^= zobrist::swap_delta(move.row_id, move.col1, move.col2, current_solution_.get_color(move.row_id, move.col1),
+                                                  current_solution_.get_color(move.row_id, move.col2));
+    std::swap(current_solution_.solution[move.row_id][move.col1], current_solution_.solution[move.row_id][move.col2]);
+    row_grid_.update(*latin_square_, evaluator_, current_solution_, affected_cells);
+
+    // 配置检测：交换的两列中的其它格子解除限制，被移动的两格重新受限
+    for (auto row = 0; row < N_; ++row) {
+        conf_changed_[row * N_ + move.col1] = 1;
+        conf_changed_[row * N_ + move.col2] = 1;
+    }
+    conf_changed_[move.row_id * N_ + move.col1] = 0;
+    conf_changed_[move.row_id * N_ + move.col2] = 0;
+    last_moved_[move.row_id * N_ + move.col1]   = iteration_;
+    last_moved_[move.row_id * N_ + move.col2]   = iteration_;
+}
+
+}// namespace qm::latin_square
@@ -1,25 +1,112 @@
 //
 // Created by qiming on 25-7-17.
 //
+#include "latin_square/anytime.h"
+#include "latin_square/binary_io.h"
+#include "latin_square/checkpoint.h"
 #include "latin_square/color_domain.h"
+#include "latin_square/incremental.h"
 #include "latin_square/instance.h"
 #include "latin_square/latin_square.h"
 #include "latin_square/local_search.h"
+#include "latin_square/server.h"
+#include "latin_square/solution_writer.h"
+#include "latin_square/solver.h"
 #include "utils/RandomGenerator.h"
+#include <atomic>
 #include <chrono>
+#include <csignal>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
 #include <string>
+#include <vector>
 
 using namespace qm::latin_square;
 
 void print_usage(const char *program_name) {
-    std::cerr << "用法: " << program_name << " <时间限制(秒)> <随机种子> <输入文件 >输出文件" << std::endl;
+    std::cerr << "用法: " << program_name << " <时间限制(秒)> <随机种子> [选项] <输入文件 >输出文件" << std::endl;
+    std::cerr << "      " << program_name << " --make-bundle <输出实例包> <实例文件>..." << std::endl;
+    std::cerr << "      " << program_name << " --serve <套接字路径|-> [--workers N] [--queue N] [--deadline 秒] [--cache-dir 目录]" << std::endl;
+    std::cerr << "选项:" << std::endl;
+    std::cerr << "  --input-format text|binary   输入实例格式（默认 text）" << std::endl;
+    std::cerr << "  --output-format text|binary  输出解格式（默认 text）" << std::endl;
+    std::cerr << "  --bundle <文件>              批量求解实例包中的所有实例（按顺序输出解）" << std::endl;
+    std::cerr << "  --engine <引擎>              搜索引擎：tabu（默认）、weighting（约束加权）、annealing（模拟退火）、memetic（模因算法）、exact（精确回溯）、" << std::endl;
+    std::cerr << "                               portfolio（多引擎并行竞速）或 auto（按实例特征自动选择）" << std::endl;
+    std::cerr << "  --selector-config <文件>     auto 引擎的选择阈值文件（key = value，见 engine_selector.h）" << std::endl;
+    std::cerr << "  --cache-dir <目录>           缓存已解实例（按行/列/符号置换规范化），命中时直接返回" << std::endl;
+    std::cerr << "  --cache-capacity <条目数>    缓存最多保留的条目数（默认 10000，按最近使用淘汰）" << std::endl;
+    std::cerr << "  --warm-start <解文件>        以旧解（文本或二进制）热启动：按新实例的固定格修复后直接搜索" << std::endl;
+    std::cerr << "  --reactive-tenure on|off     禁忌搜索按循环/平台期在线调整禁忌期（默认 off）" << std::endl;
+    std::cerr << "  --revisit-window <状态数>    反应式禁忌期的重访检测记住的最近状态数（默认 0，即只用冲突数序列；需 --reactive-tenure on）" << std::endl;
+    std::cerr << "  --path-relinking on|off      禁忌搜索重启时在精英解之间做路径重连（默认 off）" << std::endl;
+    std::cerr << "  --checkpoint <文件>          定期把搜索状态写入检查点文件" << std::endl;
+    std::cerr << "  --checkpoint-interval <秒>   检查点写入间隔（默认 300）" << std::endl;
+    std::cerr << "  --resume <文件>              从检查点继续搜索（时间限制为本次运行的时长）" << std::endl;
+    std::cerr << "  --anytime-file <文件>        最优解改进时写入该文件（原子替换），收到 SIGINT/SIGTERM 时立即写出" << std::endl;
+    std::cerr << "  --anytime-interval <秒>      两次写入 anytime 文件的最短间隔（默认 1）" << std::endl;
     std::cerr << "示例: " << program_name << " 600 123456 <../data/LSC.n50f750.00.txt >sln.LSC.n50f750.00.txt" << std::endl;
 }
 
+struct Options {
+    int time_limit_seconds   = 0;
+    unsigned int random_seed = 0;
+    bool binary_input        = false;
+    bool binary_output       = false;
+    EngineKind engine        = EngineKind::TABU;
+    std::string selector_config_path;
+    std::string cache_dir;
+    std::size_t cache_capacity = 10000;
+    std::string warm_start_path;
+    std::string bundle_path;
+    std::string checkpoint_path;
+    double checkpoint_interval_seconds = 300;
+    std::string resume_path;
+    std::string anytime_path;
+    double anytime_interval_seconds = 1.0;
+    bool reactive_tenure            = false;
+    std::size_t revisit_window      = 0;
+    bool path_relinking             = false;
+};
+
+// 由 SIGINT/SIGTERM 置位，搜索在当前迭代结束后返回历史最优解
+std::atomic<bool> stop_requested{false};
+
+extern "C" void handle_stop_signal(int signal_number) {
+    stop_requested.store(true, std::memory_order_relaxed);
+    // 再次收到同一信号时按默认方式终止进程
+    std::signal(signal_number, SIG_DFL);
+}
+
+bool parse_format(const std::string &value, bool &binary) {
+    if (value == "text") {
+        binary = false;
+        return true;
+    }
+    if (value == "binary") {
+        binary = true;
+        return true;
+    }
+    return false;
+}
+
+bool parse_switch(const std::string &value, bool &enabled) {
+    if (value == "on") {
+        enabled = true;
+        return true;
+    }
+    if (value == "off") {
+        enabled = false;
+        return true;
+    }
+    return false;
+}
+
 // 验证解的冲突数
 int verify_solution_conflicts(const Solution &solution) {
     const auto &grid    = solution.solution;
@@ -62,113 +149,304 @@ int verify_solution_conflicts(const Solution &solution) {
     return total_conflicts;
 }
 
+// 将多个文本实例打包为一个带索引的二进制实例包
+int make_bundle(const std::string &output_path, const std::vector<std::string> &input_paths) {
+    std::vector<Instance> instances;
+    instances.reserve(input_paths.size());
+    for (const auto &path: input_paths) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "错误: 无法打开实例文件 " << path << std::endl;
+            return 1;
+        }
+        in >> instances.emplace_back();
+    }
+    std::ofstream out(output_path, std::ios::binary);
+    if (!out) {
+        std::cerr << "错误: 无法写入 " << output_path << std::endl;
+        return 1;
+    }
+    binary::write_bundle(out, instances);
+    std::cerr << "已打包 " << instances.size() << " 个实例到 " << output_path << std::endl;
+    return 0;
+}
+
+// 输出解到标准输出；文本格式整体格式化后一次写出，separated 为真时在末尾追加空行
+void write_solution(const Solution &solution, bool binary_output, bool separated = false) {
+    if (binary_output) {
+        binary::write_solution(std::cout, solution);
+        return;
+    }
+    static SolutionWriter writer;
+    writer.write(std::cout, solution, separated);
+}
+
+// 读取热启动用的旧解：以解记录魔数开头时按二进制解析，否则按文本解析
+Solution load_warm_start(const std::string &path, const int n) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) { throw std::runtime_error("Cannot open warm start solution " + path); }
+    const binary::Bytes bytes{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    if (binary::is_solution_record(bytes)) { return binary::decode_solution(bytes); }
+    std::istringstream text(std::string(bytes.begin(), bytes.end()));
+    return read_text_solution(text, n);
+}
+
+Solution solve(Solver &solver, const std::shared_ptr<Instance> &instance, const Solution *warm_start = nullptr) {
+    const auto result = warm_start != nullptr ? solver.solve_from(instance, *warm_start, &stop_requested) : solver.solve(instance, &stop_requested);
+    if (result.repair_swaps >= 0) { std::cerr << "热启动: 修复旧解用了 " << result.repair_swaps << " 次行内交换" << std::endl; }
+    if (result.iterations > 0) { std::cerr << "实际运行时间: " << result.elapsed_seconds << " 秒" << std::endl; }
+    if (result.cached) { std::cerr << "缓存命中" << std::endl; }
+    if (result.reduced_size > 0) { std::cerr << "问题收缩: " << instance->size() << " -> " << result.reduced_size << std::endl; }
+    if (solver.config().engine == EngineKind::AUTO) { std::cerr << "自动选择引擎: " << engine_kind_name(result.engine) << std::endl; }
+    if (result.infeasible) { std::cerr << "实例无解：精确搜索已穷尽所有可能" << std::endl; }
+    return result.solution;
+}
+
+// 常驻服务模式：监听 Unix 域套接字，或以 "-" 表示从标准输入读取分帧请求并写回标准输出
+int serve(int argc, char *argv[]) {
+    const std::string endpoint = argv[2];
+    ServerConfig config;
+    try {
+        for (int i = 3; i + 1 < argc; i += 2) {
+            const std::string arg = argv[i];
+            if (arg == "--workers") {
+                config.workers = std::stoi(argv[i + 1]);
+            } else if (arg == "--queue") {
+                config.queue_capacity = std::stoul(argv[i + 1]);
+            } else if (arg == "--deadline") {
+                config.default_deadline_seconds = std::stod(argv[i + 1]);
+            } else if (arg == "--cache-dir") {
+                config.cache_dir = argv[i + 1];
+            } else {
+                throw std::invalid_argument("unknown option " + arg);
+            }
+        }
+        if (argc % 2 == 0) { throw std::invalid_argument("option is missing its value"); }
+    } catch (const std::exception &e) {
+        std::cerr << "错误: 参数解析失败 - " << e.what() << std::endl;
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    try {
+        SolverServer server(config);
+        if (endpoint == "-") {
+            server.serve_stream(0, 1);
+        } else {
+            std::cerr << "监听: " << endpoint << std::endl;
+            server.serve_unix_socket(endpoint);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "错误: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
+    if (argc >= 3 && std::string(argv[1]) == "--serve") { return serve(argc, argv); }
+
+    if (argc >= 2 && std::string(argv[1]) == "--make-bundle") {
+        if (argc < 4) {
+            std::cerr << "错误: --make-bundle 需要输出文件和至少一个实例文件" << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+        return make_bundle(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+    }
+
     // 检查命令行参数
-    if (argc != 3) {
+    if (argc < 3) {
         std::cerr << "错误: 参数数量不正确" << std::endl;
         print_usage(argv[0]);
         return 1;
     }
 
     // 解析命令行参数
-    int time_limit_seconds   = 0;
-    unsigned int random_seed = 0;
+    Options options;
 
     try {
-        time_limit_seconds = std::stoi(argv[1]);
-        random_seed        = static_cast<unsigned int>(std::stoul(argv[2]));
+        options.time_limit_seconds = std::stoi(argv[1]);
+        options.random_seed        = static_cast<unsigned int>(std::stoul(argv[2]));
     } catch (const std::exception &e) {
         std::cerr << "错误: 参数解析失败 - " << e.what() << std::endl;
         print_usage(argv[0]);
         return 1;
     }
 
-    if (time_limit_seconds <= 0) {
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "错误: 选项 " << arg << " 缺少参数" << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+        const std::string value = argv[++i];
+        bool ok                 = true;
+        if (arg == "--input-format") {
+            ok = parse_format(value, options.binary_input);
+        } else if (arg == "--output-format") {
+            ok = parse_format(value, options.binary_output);
+        } else if (arg == "--engine") {
+            ok = parse_engine_kind(value, options.engine);
+        } else if (arg == "--warm-start") {
+            options.warm_start_path = value;
+        } else if (arg == "--cache-dir") {
+            options.cache_dir = value;
+        } else if (arg == "--cache-capacity") {
+            try {
+                options.cache_capacity = std::stoul(value);
+            } catch (const std::exception &) { ok = false; }
+        } else if (arg == "--selector-config") {
+            options.selector_config_path = value;
+        } else if (arg == "--bundle") {
+            options.bundle_path = value;
+        } else if (arg == "--checkpoint") {
+            options.checkpoint_path = value;
+        } else if (arg == "--checkpoint-interval") {
+            try {
+                options.checkpoint_interval_seconds = std::stod(value);
+            } catch (const std::exception &) { ok = false; }
+            ok = ok && options.checkpoint_interval_seconds > 0;
+        } else if (arg == "--resume") {
+            options.resume_path = value;
+        } else if (arg == "--reactive-tenure") {
+            ok = parse_switch(value, options.reactive_tenure);
+        } else if (arg == "--revisit-window") {
+            try {
+                options.revisit_window = std::stoul(value);
+            } catch (const std::exception &) { ok = false; }
+        } else if (arg == "--path-relinking") {
+            ok = parse_switch(value, options.path_relinking);
+        } else if (arg == "--anytime-file") {
+            options.anytime_path = value;
+        } else if (arg == "--anytime-interval") {
+            try {
+                options.anytime_interval_seconds = std::stod(value);
+            } catch (const std::exception &) { ok = false; }
+            ok = ok && options.anytime_interval_seconds >= 0;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            std::cerr << "错误: 无法识别的选项 " << arg << " " << value << std::endl;
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.time_limit_seconds <= 0) {
         std::cerr << "错误: 时间限制必须为正数" << std::endl;
         return 1;
     }
+    if (!options.bundle_path.empty() && (!options.checkpoint_path.empty() || !options.resume_path.empty())) {
+        std::cerr << "错误: 批量模式不支持检查点" << std::endl;
+        return 1;
+    }
+    if (!options.warm_start_path.empty() && (!options.bundle_path.empty() || !options.resume_path.empty())) {
+        std::cerr << "错误: 热启动不能与批量模式或检查点恢复同时使用" << std::endl;
+        return 1;
+    }
+    if (options.engine != EngineKind::TABU && (!options.checkpoint_path.empty() || !options.resume_path.empty())) {
+        std::cerr << "错误: 检查点只支持禁忌搜索引擎" << std::endl;
+        return 1;
+    }
+    if (!options.bundle_path.empty() && !options.anytime_path.empty()) {
+        std::cerr << "错误: 批量模式不支持 anytime 输出" << std::endl;
+        return 1;
+    }
 
-    std::cerr << "时间限制: " << time_limit_seconds << " 秒" << std::endl;
-    std::cerr << "随机种子: " << random_seed << std::endl;
+    std::cerr << "时间限制: " << options.time_limit_seconds << " 秒" << std::endl;
+    std::cerr << "随机种子: " << options.random_seed << std::endl;
 
     // 加速输入输出
     std::ios::sync_with_stdio(false);
     std::cin.tie(nullptr);
 
-    // 从标准输入读取实例
-    const auto instance = std::make_shared<Instance>();
-    std::cin >> *instance;
-
-    qm::setRandomSeed(random_seed);
+    SolverConfig config;
+    config.time_limit_seconds           = options.time_limit_seconds;
+    config.seed                         = options.random_seed;
+    config.engine                       = options.engine;
+    config.checkpoint_path              = options.checkpoint_path;
+    config.checkpoint_interval_seconds  = options.checkpoint_interval_seconds;
+    config.cache_dir                    = options.cache_dir;
+    config.cache_capacity               = options.cache_capacity;
+    config.search.tenure.reactive       = options.reactive_tenure;
+    config.search.tenure.revisit_window = options.revisit_window;
+    config.search.relinking.enabled     = options.path_relinking;
+    if (!options.selector_config_path.empty()) {
+        try {
+            config.selector = load_selector_thresholds(options.selector_config_path);
+        } catch (const std::exception &e) {
+            std::cerr << "错误: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+    Solver solver(config);
 
+    std::signal(SIGINT, handle_stop_signal);
+    std::signal(SIGTERM, handle_stop_signal);
 
-    // 初始化拉丁方和解
-    auto latin_square = LatinSquare(instance);
-    auto solution     = latin_square.generate_init_solution();
+    std::unique_ptr<AnytimeWriter> anytime;
+    if (!options.anytime_path.empty()) {
+        anytime = std::make_unique<AnytimeWriter>(options.anytime_path, options.anytime_interval_seconds, options.binary_output);
+        solver.set_improvement_callback([&anytime](const Solution &best, unsigned long long) {
+            // 旁路文件写入失败不应中断搜索
+            try {
+                anytime->offer(best);
+            } catch (const std::exception &e) { std::cerr << "警告: anytime 文件写入失败 - " << e.what() << std::endl; }
+        });
+    }
 
-    if (solution.total_conflict == 0) {
-        for (const auto &row: solution.solution) {
-            for (size_t i = 0; i < row.size(); ++i) {
-                if (i > 0) std::cout << " ";
-                std::cout << row[i];
+    try {
+        if (!options.bundle_path.empty()) {
+            // 批量模式：映射实例包，逐个求解并按顺序输出
+            const binary::MappedFile file(options.bundle_path);
+            const binary::BundleView bundle(file.bytes());
+            std::cerr << "实例包: " << options.bundle_path << "，共 " << bundle.size() << " 个实例" << std::endl;
+            for (std::size_t i = 0; i < bundle.size(); ++i) {
+                const auto instance = std::make_shared<Instance>(bundle.at(i));
+                const auto solution = solve(solver, instance);
+                // 收到停止信号时输出被中断实例的最优解后结束，不再求解后续实例
+                const bool stopped = stop_requested.load(std::memory_order_relaxed);
+                // 文本格式下用空行分隔相邻的解
+                write_solution(solution, options.binary_output, !stopped && i + 1 < bundle.size());
+                if (stopped) {
+                    std::cerr << "收到停止信号，已输出 " << i + 1 << " / " << bundle.size() << " 个实例的解" << std::endl;
+                    return 130;
+                }
             }
-            std::cout << std::endl;
+            return 0;
         }
-        return 0;
-    }
-
-    // 设置随机种子
-
-    // 记录开始时间
-    auto start_time = std::chrono::high_resolution_clock::now();
-
-    // 创建局部搜索对象
-    LocalSearch local_search;
-
-    // 计算最大迭代次数（设置一个足够大的值，实际由时间限制控制）
-    unsigned long long max_iterations = 100000000000ULL;
-
-    // 执行搜索（传递时间限制）
-    local_search.search(latin_square, solution, max_iterations, time_limit_seconds);
-
-    // 计算实际运行时间
-    auto end_time                         = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed = end_time - start_time;
-
-    std::cerr << "实际运行时间: " << elapsed.count() << " 秒" << std::endl;
-
-    // 获取最终解
-    const auto &best_solution = local_search.best_solution_;
-    //
-    // // 验证解的冲突数
-    // std::cerr << "\n=== 输出前验证 ===" << std::endl;
-    // int verified_conflicts = verify_solution_conflicts(best_solution);
-    //
-    // // 检查是否与算法报告的冲突数一致
-    // if (verified_conflicts != best_solution.total_conflict) {
-    //     std::cerr << "警告: 验证的冲突数 (" << verified_conflicts
-    //               << ") 与算法报告的冲突数 (" << best_solution.total_conflict
-    //               << ") 不一致!" << std::endl;
-    // } else {
-    //     std::cerr << "验证通过: 冲突数一致" << std::endl;
-    // }
-    //
-    // if (verified_conflicts > 0) {
-    //     std::cerr << "警告: 解仍有 " << verified_conflicts << " 个冲突，不是可行解" << std::endl;
-    // } else {
-    //     std::cerr << "成功: 找到可行解（无冲突）" << std::endl;
-    // }
-    // std::cerr << "==================\n"
-    //           << std::endl;
-
-    // 输出最终解到标准输出
-    for (const auto &row: best_solution.solution) {
-        for (size_t i = 0; i < row.size(); ++i) {
-            if (i > 0) std::cout << " ";
-            std::cout << row[i];
+
+        // 从标准输入读取实例
+        const auto instance = std::make_shared<Instance>();
+        if (options.binary_input) {
+            *instance = binary::read_instance(std::cin);
+        } else {
+            std::cin >> *instance;
+        }
+
+        if (!options.resume_path.empty()) {
+            const auto checkpoint = load_checkpoint(options.resume_path);
+            std::cerr << "检查点: " << options.resume_path << "，已搜索 " << checkpoint.elapsed_seconds << " 秒" << std::endl;
+            const auto result = solver.resume(instance, checkpoint, &stop_requested);
+            std::cerr << "实际运行时间: " << result.elapsed_seconds << " 秒" << std::endl;
+            if (anytime) { anytime->flush(); }
+            write_solution(result.solution, options.binary_output);
+            return 0;
         }
-        std::cout << std::endl;
+
+        std::optional<Solution> warm_start;
+        if (!options.warm_start_path.empty()) { warm_start = load_warm_start(options.warm_start_path, instance->size()); }
+        const auto solution = solve(solver, instance, warm_start ? &*warm_start : nullptr);
+        // 先把限速期内暂存的最优解写入 anytime 文件，再输出最终解到标准输出
+        if (anytime) { anytime->flush(); }
+        write_solution(solution, options.binary_output);
+    } catch (const std::exception &e) {
+        std::cerr << "错误: " << e.what() << std::endl;
+        return 1;
     }
 
     return 0;
-}
\ No newline at end of file
+}
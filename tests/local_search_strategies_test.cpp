@@ -0,0 +1,125 @@
+/**
+ * @file local_search_strategies_test.cpp
+ * @brief 禁忌搜索可选策略的冒烟测试：打开策略后遥测计数器须非零，关闭时须为零
+ *
+ * 用法：local_search_strategies_test <策略名>，返回 0 表示通过。
+ * 实例由固定种子的循环拉丁方打乱后挖空得到，规模与预填比例使其在迭代上限内解不出，
+ * 搜索总是跑满迭代上限，计数器不依赖随机数引擎的具体实现。
+ */
+
+#include "latin_square/latin_square.h"
+#include "latin_square/local_search.h"
+#include "utils/RandomGenerator.h"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+using namespace qm::latin_square;
+
+namespace {
+
+constexpr int ORDER                     = 30;
+constexpr double FILL                   = 0.65;
+constexpr unsigned long long ITERATIONS = 20000;
+
+// 打乱行、列与颜色的循环拉丁方，按 FILL 的比例保留格子作为固定格
+std::shared_ptr<Instance> make_instance() {
+    std::mt19937 engine(20261018);
+    std::vector<int> rows(ORDER), cols(ORDER), colors(ORDER);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::iota(cols.begin(), cols.end(), 0);
+    std::iota(colors.begin(), colors.end(), 0);
+    std::shuffle(rows.begin(), rows.end(), engine);
+    std::shuffle(cols.begin(), cols.end(), engine);
+    std::shuffle(colors.begin(), colors.end(), engine);
+
+    std::bernoulli_distribution keep(FILL);
+    std::stringstream text;
+    text << ORDER << '\n';
+    for (auto i = 0; i < ORDER; ++i) {
+        for (auto j = 0; j < ORDER; ++j) {
+            if (keep(engine)) { text << rows[i] << ' ' << cols[j] << ' ' << colors[(i + j) % ORDER] << '\n'; }
+        }
+    }
+    auto instance = std::make_shared<Instance>();
+    text >> *instance;
+    return instance;
+}
+
+SearchTelemetry run(const SearchConfig &config) {
+    qm::setRandomSeed(1);
+    LatinSquare latin_square(make_instance());
+    const auto solution = latin_square.generate_init_solution();
+    LocalSearch search(config);
+    search.search(latin_square, solution, ITERATIONS);
+    if (search.best_solution().total_conflict == 0) { std::cerr << "实例在迭代上限内已解出，测试无法判定" << std::endl; }
+    return search.telemetry();
+}
+
+SearchConfig quiet_config() {
+    SearchConfig config;
+    config.verbose = false;
+    return config;
+}
+
+bool check(const bool condition, const std::string_view message) {
+    if (!condition) { std::cerr << "失败: " << message << std::endl; }
+    return condition;
+}
+
+// 反应式禁忌期：打开后控制器调整禁忌期，关闭时禁忌期保持初值（初值高于下界，减小也能观察到）
+bool test_reactive_tenure() {
+    auto config       = quiet_config();
+    config.tabu_alpha = 0.8;
+    const auto off    = run(config);
+    config.tenure.reactive = true;
+    const auto on          = run(config);
+    return check(off.tenure_increases + off.tenure_decreases == 0 && off.tabu_alpha == config.tabu_alpha, "关闭时不应调整禁忌期")
+           && check(on.tenure_increases + on.tenure_decreases > 0, "打开后应调整禁忌期");
+}
+
+// 重访检测：只在反应式禁忌期打开且窗口非零时记录重访
+bool test_revisit_window() {
+    auto config                  = quiet_config();
+    config.tenure.revisit_window = 8192;
+    const auto without_reactive  = run(config);
+    config.tenure.reactive       = true;
+    config.tenure.revisit_window = 0;
+    const auto without_window    = run(config);
+    config.tenure.revisit_window = 8192;
+    const auto on                = run(config);
+    return check(without_reactive.revisits == 0, "反应式禁忌期关闭时不应记录重访") && check(without_window.revisits == 0, "窗口为 0 时不应记录重访")
+           && check(on.revisits > 0, "打开后应检测到重访");
+}
+
+// 路径重连：只在重启时触发，调低重启阈值并每次重启都尝试重连
+bool test_path_relinking() {
+    auto config              = quiet_config();
+    config.restart_threshold = 2;
+    config.relinking.period  = 1;
+    const auto off           = run(config);
+    config.relinking.enabled = true;
+    const auto on            = run(config);
+    return check(off.restarts > 0 && on.restarts > 0, "应发生重启") && check(off.relinks == 0, "关闭时不应路径重连") && check(on.relinks > 0, "打开后应以重连的中间解重启");
+}
+
+}// namespace
+
+int main(const int argc, char *argv[]) {
+    if (argc != 2) {
+        std::cerr << "用法: " << argv[0] << " <策略名>" << std::endl;
+        return 2;
+    }
+    const std::string_view name = argv[1];
+    if (name == "reactive_tenure") { return test_reactive_tenure() ? 0 : 1; }
+    if (name == "revisit_window") { return test_revisit_window() ? 0 : 1; }
+    if (name == "path_relinking") { return test_path_relinking() ? 0 : 1; }
+    std::cerr << "未知策略: " << name << std::endl;
+    return 2;
+}